@@ -0,0 +1,117 @@
+//autosaver.cpp
+#include "AutoSaver.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+AutoSaver::AutoSaver(const std::string& path)
+    : path_(path)
+    , hasPending_(false)
+    , stopping_(false) {
+    writer_ = std::thread(&AutoSaver::writeLoop, this);
+}
+
+AutoSaver::~AutoSaver() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_one();
+    writer_.join();
+}
+
+void AutoSaver::submit(std::vector<uint8_t> snapshot) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = std::move(snapshot);
+        hasPending_ = true;
+    }
+    changed_.notify_one();
+}
+
+void AutoSaver::writeLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        changed_.wait(lock, [this]() { return hasPending_ || stopping_; });
+        if (!hasPending_) {
+            return; // stopping with nothing left to write
+        }
+        
+        std::vector<uint8_t> snapshot = std::move(pending_);
+        hasPending_ = false;
+        lock.unlock();
+        write(path_, snapshot); // a failed save is retried with the next move
+        lock.lock();
+    }
+}
+
+bool AutoSaver::read(const std::string& path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !file.bad();
+}
+
+bool AutoSaver::write(const std::string& path, const std::vector<uint8_t>& data) {
+    std::string temporary = path + ".tmp";
+
+#ifndef _WIN32
+    int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n <= 0) {
+            close(fd);
+            std::remove(temporary.c_str());
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    // The data must be on disk before the rename makes it the save
+    bool synced = fsync(fd) == 0;
+    close(fd);
+    if (!synced) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+#else
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(reinterpret_cast<const char*>(data.data()),
+                                 static_cast<std::streamsize>(data.size())) || !file.flush()) {
+            return false;
+        }
+    }
+    std::remove(path.c_str()); // rename does not replace an existing file here
+#endif
+    
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+#ifndef _WIN32
+    // Persist the rename itself
+    std::string directory = ".";
+    size_t slash = path.find_last_of('/');
+    if (slash != std::string::npos) {
+        directory = slash == 0 ? "/" : path.substr(0, slash);
+    }
+    int dirFd = open(directory.c_str(), O_RDONLY);
+    if (dirFd >= 0) {
+        fsync(dirFd);
+        close(dirFd);
+    }
+#endif
+    return true;
+}
@@ -0,0 +1,39 @@
+//autosaver.h
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Writes save snapshots on a background thread, so the frame loop never
+// waits on the disk. Only the newest snapshot not yet written is kept.
+// Each write goes to a temporary file that is flushed to disk and renamed
+// over the target, so a power cut leaves either the old save or the new one.
+class AutoSaver {
+public:
+    explicit AutoSaver(const std::string& path);
+    // Writes the snapshot still pending, if any
+    ~AutoSaver();
+    
+    AutoSaver(const AutoSaver&) = delete;
+    AutoSaver& operator=(const AutoSaver&) = delete;
+    
+    void submit(std::vector<uint8_t> snapshot);
+    
+    static bool read(const std::string& path, std::vector<uint8_t>& data);
+    static bool write(const std::string& path, const std::vector<uint8_t>& data);
+    
+private:
+    std::string path_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::vector<uint8_t> pending_;
+    bool hasPending_;
+    bool stopping_;
+    std::thread writer_;
+    
+    void writeLoop();
+};
@@ -0,0 +1,575 @@
+//batchtool.cpp
+#include "BatchTool.h"
+#include "Board.h"
+#include "GenerationTelemetry.h"
+#include "GridSampler.h"
+#include "HardPuzzleMiner.h"
+#include "SudokuCanonicalizer.h"
+#include "SudokuDaemon.h"
+#include "SolverFuzzer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+int BatchTool::run(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+    
+    std::string command = argv[1];
+    std::vector<std::string> args(argv + 2, argv + argc);
+    
+    if (command == "dedup") {
+        return runDedup(args);
+    } else if (command == "serve") {
+        return runServe(args);
+    } else if (command == "generate") {
+        return runGenerate(args);
+    } else if (command == "fuzz") {
+        return runFuzz(args);
+    } else if (command == "mine") {
+        return runMine(args);
+    }
+    
+    printUsage();
+    return 1;
+}
+
+void BatchTool::printUsage() {
+    std::cerr << "Usage:" << std::endl;
+    std::cerr << "  sudoku dedup <input> [-o output] [-j threads]" << std::endl;
+    std::cerr << "      Drop puzzles that are symmetry-equivalent to an earlier line" << std::endl;
+    std::cerr << "  sudoku serve <socket> [-j threads] [--inventory count] [--timeout ms]" << std::endl;
+    std::cerr << "      Serve solve/count/generate/grade requests on a Unix socket" << std::endl;
+    std::cerr << "  sudoku generate -n count [-d easy,medium,hard,expert] [-o output]" << std::endl;
+    std::cerr << "                  [-j threads] [--seed seed] [--binary] [--ordered]" << std::endl;
+    std::cerr << "                  [--metrics file.json|file.prom]" << std::endl;
+    std::cerr << "                  [--symmetry none|rotate180|rotate90|mirror|mirror-both]" << std::endl;
+    std::cerr << "                  [--grid-pool size] [--minimal] [--minimal-time ms]" << std::endl;
+    std::cerr << "                  [--variant classic|x|hyper|jigsaw|killer]" << std::endl;
+    std::cerr << "      Generate count puzzles per difficulty, streamed as they finish" << std::endl;
+    std::cerr << "  sudoku fuzz [-n boards] [-j threads] [--seed seed] [--timeout ms]" << std::endl;
+    std::cerr << "              [--variants boards]" << std::endl;
+    std::cerr << "      Check every solver against the reference backtracker; exit 1 on mismatch" << std::endl;
+    std::cerr << "  sudoku mine -o corpus [-k count] [-t seconds] [-j threads] [--seed seed]" << std::endl;
+    std::cerr << "              [--engine bitboard|backtrack]" << std::endl;
+    std::cerr << "      Search for the puzzles that cost the engine the most nodes" << std::endl;
+}
+
+int BatchTool::runDedup(const std::vector<std::string>& args) {
+    std::string inputPath;
+    std::string outputPath;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "-o" && i + 1 < args.size()) {
+            outputPath = args[++i];
+        } else if (args[i] == "-j" && i + 1 < args.size()) {
+            threads = parseThreads(args[++i]);
+        } else if (inputPath.empty()) {
+            inputPath = args[i];
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    
+    std::vector<std::string> lines;
+    if (inputPath.empty() || !readLines(inputPath, lines)) {
+        std::cerr << "Could not read puzzles from '" << inputPath << "'" << std::endl;
+        return 1;
+    }
+    
+    // Canonicalise in parallel; the order-preserving filter below is cheap
+    std::vector<SudokuCanonicalizer::Grid> canonical(lines.size());
+    std::vector<uint64_t> hashes(lines.size());
+    std::vector<char> valid(lines.size(), 0);
+    std::atomic<size_t> nextIndex(0);
+    const size_t chunk = 64;
+    
+    auto worker = [&]() {
+        for (;;) {
+            size_t begin = nextIndex.fetch_add(chunk);
+            if (begin >= lines.size()) break;
+            size_t end = std::min(begin + chunk, lines.size());
+            for (size_t i = begin; i < end; ++i) {
+                Board board;
+                if (Board::fromString(lines[i], board)) {
+                    canonical[i] = SudokuCanonicalizer::canonicalGrid(board);
+                    hashes[i] = SudokuCanonicalizer::hashGrid(canonical[i]);
+                    valid[i] = 1;
+                }
+            }
+        }
+    };
+    
+    std::vector<std::thread> pool;
+    for (int t = 1; t < std::max(threads, 1); ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file) {
+            std::cerr << "Could not write '" << outputPath << "'" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+    
+    // Kept lines by hash; a hash hit is only a duplicate if the canonical forms match
+    std::unordered_map<uint64_t, std::vector<size_t>> seen;
+    size_t kept = 0;
+    size_t invalid = 0;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (!valid[i]) {
+            invalid++;
+            continue;
+        }
+        std::vector<size_t>& matches = seen[hashes[i]];
+        bool duplicate = std::any_of(matches.begin(), matches.end(),
+                                     [&](size_t j) { return canonical[j] == canonical[i]; });
+        if (!duplicate) {
+            matches.push_back(i);
+            out << lines[i] << '\n';
+            kept++;
+        }
+    }
+    
+    std::cerr << "Read " << lines.size() << " lines, kept " << kept
+              << ", dropped " << (lines.size() - kept - invalid) << " duplicates and "
+              << invalid << " malformed lines" << std::endl;
+    return 0;
+}
+
+int BatchTool::runServe(const std::vector<std::string>& args) {
+    DaemonOptions options;
+    
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "-j" && i + 1 < args.size()) {
+            options.threads = parseThreads(args[++i]);
+        } else if (args[i] == "--inventory" && i + 1 < args.size()) {
+            options.inventoryPerDifficulty = static_cast<size_t>(std::max(0, std::atoi(args[++i].c_str())));
+        } else if (args[i] == "--timeout" && i + 1 < args.size()) {
+            options.requestTimeout = std::chrono::milliseconds(std::max(1, std::atoi(args[++i].c_str())));
+        } else if (options.socketPath.empty()) {
+            options.socketPath = args[i];
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    
+    SudokuDaemon daemon(options);
+    return daemon.run() ? 0 : 1;
+}
+
+int BatchTool::runGenerate(const std::vector<std::string>& args) {
+    int perDifficulty = 0;
+    std::vector<Difficulty> difficulties = {
+        Difficulty::EASY, Difficulty::MEDIUM, Difficulty::HARD, Difficulty::EXPERT
+    };
+    std::string outputPath;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    bool seeded = false;
+    uint32_t baseSeed = 0;
+    bool binary = false;
+    bool ordered = false;
+    std::string metricsPath;
+    Symmetry symmetry = Symmetry::NONE;
+    size_t gridPoolSize = 0;
+    bool minimal = false;
+    int minimalMillis = 1000;
+    std::string variant = "classic";
+    
+    for (size_t i = 0; i < args.size(); ++i) {
+        bool hasValue = i + 1 < args.size();
+        if (args[i] == "-n" && hasValue) {
+            perDifficulty = std::atoi(args[++i].c_str());
+        } else if (args[i] == "-d" && hasValue) {
+            if (!parseDifficulties(args[++i], difficulties)) {
+                printUsage();
+                return 1;
+            }
+        } else if (args[i] == "-o" && hasValue) {
+            outputPath = args[++i];
+        } else if (args[i] == "-j" && hasValue) {
+            threads = parseThreads(args[++i]);
+        } else if (args[i] == "--seed" && hasValue) {
+            seeded = true;
+            baseSeed = static_cast<uint32_t>(std::strtoul(args[++i].c_str(), nullptr, 10));
+        } else if (args[i] == "--binary") {
+            binary = true;
+        } else if (args[i] == "--ordered") {
+            ordered = true;
+        } else if (args[i] == "--metrics" && hasValue) {
+            metricsPath = args[++i];
+        } else if (args[i] == "--grid-pool" && hasValue) {
+            gridPoolSize = static_cast<size_t>(std::max(0, std::atoi(args[++i].c_str())));
+        } else if (args[i] == "--minimal") {
+            minimal = true;
+        } else if (args[i] == "--minimal-time" && hasValue) {
+            minimalMillis = std::max(1, std::atoi(args[++i].c_str()));
+        } else if (args[i] == "--variant" && hasValue) {
+            if (!parseVariant(args[++i], variant)) {
+                printUsage();
+                return 1;
+            }
+        } else if (args[i] == "--symmetry" && hasValue) {
+            if (!parseSymmetry(args[++i], symmetry)) {
+                printUsage();
+                return 1;
+            }
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (perDifficulty <= 0) {
+        printUsage();
+        return 1;
+    }
+    // Variant puzzles come from VariantGenerator, which has none of these
+    if (variant != "classic" && (binary || minimal || symmetry != Symmetry::NONE || gridPoolSize > 0)) {
+        std::cerr << "--variant does not combine with --binary, --minimal, --symmetry or --grid-pool"
+                  << std::endl;
+        return 1;
+    }
+    
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath, binary ? std::ios::binary : std::ios::out);
+        if (!file) {
+            std::cerr << "Could not write '" << outputPath << "'" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+    
+    std::unique_ptr<GridPool> gridPool;
+    if (gridPoolSize > 0) {
+        gridPool = std::make_unique<GridPool>(gridPoolSize, seeded ? baseSeed : std::random_device()());
+    }
+    
+    // Sequence numbers interleave difficulties so every one makes progress
+    size_t total = static_cast<size_t>(perDifficulty) * difficulties.size();
+    std::atomic<size_t> nextJob(0);
+    
+    std::mutex outputMutex;
+    std::map<size_t, std::string> reorderBuffer;
+    size_t nextToWrite = 0;
+    size_t finished = 0;
+    GenerationTelemetry telemetry;
+    CancellationToken neverCancelled;
+    auto start = std::chrono::steady_clock::now();
+    auto lastReport = start;
+    
+    auto encode = [binary](Difficulty difficulty, const Board& puzzle) {
+        std::string text = puzzle.toString();
+        if (!binary) {
+            return text + '\n';
+        }
+        // Packed record: difficulty byte, then two cells per byte (high nibble first)
+        std::string record(1 + (text.size() + 1) / 2, '\0');
+        record[0] = static_cast<char>(difficulty);
+        for (size_t i = 0; i < text.size(); ++i) {
+            int value = text[i] - '0';
+            record[1 + i / 2] |= static_cast<char>(i % 2 == 0 ? value << 4 : value);
+        }
+        return record;
+    };
+    
+    auto worker = [&]() {
+        for (;;) {
+            size_t job = nextJob.fetch_add(1);
+            if (job >= total) break;
+            
+            Difficulty difficulty = difficulties[job % difficulties.size()];
+            GeneratorOptions options;
+            options.telemetry = &telemetry;
+            options.symmetry = symmetry;
+            options.gridPool = gridPool.get();
+            if (seeded) {
+                options.seed = baseSeed + static_cast<uint32_t>(job);
+            }
+            
+            std::string record;
+            if (variant != "classic") {
+                VariantPuzzle puzzle = generateVariant(variant, difficulty, options);
+                // A jigsaw whose layouts all failed to fill leaves no record
+                if (puzzle.clueCount > 0) {
+                    record = encodeVariant(puzzle) + '\n';
+                }
+            } else {
+                // Expert puzzles search for a minimal clue set until their time is up
+                options.minimalSearch = minimal && difficulty == Difficulty::EXPERT;
+                GenerationResult generated = options.minimalSearch
+                    ? SudokuGenerator::generate(difficulty, options,
+                                                std::chrono::steady_clock::now() +
+                                                    std::chrono::milliseconds(minimalMillis),
+                                                neverCancelled)
+                    : SudokuGenerator::generate(difficulty, options);
+                record = encode(difficulty, generated.puzzle);
+            }
+            
+            std::lock_guard<std::mutex> lock(outputMutex);
+            if (ordered) {
+                // Hold finished records until every earlier one has been written
+                reorderBuffer.emplace(job, std::move(record));
+                while (!reorderBuffer.empty() && reorderBuffer.begin()->first == nextToWrite) {
+                    out << reorderBuffer.begin()->second;
+                    reorderBuffer.erase(reorderBuffer.begin());
+                    nextToWrite++;
+                }
+            } else {
+                out << record;
+            }
+            
+            finished++;
+            auto end = std::chrono::steady_clock::now();
+            if (end - lastReport >= std::chrono::seconds(1) || finished == total) {
+                lastReport = end;
+                double seconds = std::chrono::duration<double>(end - start).count();
+                std::cerr << "\rgenerated " << finished << "/" << total << "  "
+                          << static_cast<int>(finished / std::max(seconds, 1e-9)) << " puzzles/s   "
+                          << std::flush;
+            }
+        }
+    };
+    
+    std::vector<std::thread> pool;
+    for (int t = 1; t < std::max(threads, 1); ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    out.flush();
+    
+    std::cerr << std::endl;
+    telemetry.print(std::cerr);
+    
+    // Prometheus text for *.prom (node exporter textfile collector), JSON otherwise
+    if (!metricsPath.empty()) {
+        bool prometheus = metricsPath.size() >= 5 &&
+                          metricsPath.compare(metricsPath.size() - 5, 5, ".prom") == 0;
+        bool written = prometheus ? telemetry.exportPrometheus(metricsPath)
+                                  : telemetry.exportJson(metricsPath);
+        if (!written) {
+            std::cerr << "Could not write '" << metricsPath << "'" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int BatchTool::runFuzz(const std::vector<std::string>& args) {
+    FuzzOptions options;
+    
+    for (size_t i = 0; i < args.size(); ++i) {
+        bool hasValue = i + 1 < args.size();
+        if (args[i] == "-n" && hasValue) {
+            options.boards = static_cast<size_t>(std::max(0, std::atoi(args[++i].c_str())));
+        } else if (args[i] == "-j" && hasValue) {
+            options.threads = parseThreads(args[++i]);
+        } else if (args[i] == "--seed" && hasValue) {
+            options.seed = static_cast<uint32_t>(std::strtoul(args[++i].c_str(), nullptr, 10));
+        } else if (args[i] == "--timeout" && hasValue) {
+            options.timeLimit = std::chrono::milliseconds(std::max(1, std::atoi(args[++i].c_str())));
+        } else if (args[i] == "--variants" && hasValue) {
+            options.variantBoards = static_cast<size_t>(std::max(0, std::atoi(args[++i].c_str())));
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    
+    FuzzReport report = SolverFuzzer::run(options);
+    SolverFuzzer::print(report, std::cout);
+    return report.mismatches == 0 ? 0 : 1;
+}
+
+int BatchTool::runMine(const std::vector<std::string>& args) {
+    MinerOptions options;
+    std::string outputPath;
+    int seconds = 60;
+    
+    for (size_t i = 0; i < args.size(); ++i) {
+        bool hasValue = i + 1 < args.size();
+        if (args[i] == "-o" && hasValue) {
+            outputPath = args[++i];
+        } else if (args[i] == "-k" && hasValue) {
+            options.topK = static_cast<size_t>(std::max(1, std::atoi(args[++i].c_str())));
+        } else if (args[i] == "-t" && hasValue) {
+            seconds = std::max(1, std::atoi(args[++i].c_str()));
+        } else if (args[i] == "-j" && hasValue) {
+            options.threads = parseThreads(args[++i]);
+        } else if (args[i] == "--seed" && hasValue) {
+            options.seed = static_cast<uint32_t>(std::strtoul(args[++i].c_str(), nullptr, 10));
+        } else if (args[i] == "--engine" && hasValue) {
+            std::string name = args[++i];
+            if (name == HardPuzzleMiner::getEngineName(MinerEngine::BACKTRACK)) {
+                options.engine = MinerEngine::BACKTRACK;
+            } else if (name != HardPuzzleMiner::getEngineName(MinerEngine::BITBOARD)) {
+                printUsage();
+                return 1;
+            }
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (outputPath.empty()) {
+        printUsage();
+        return 1;
+    }
+    
+    SearchLimits limits;
+    limits.deadline = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    MinerResult result = HardPuzzleMiner::mine(options, limits);
+    
+    // Hardest first, one puzzle per line, so the corpus reads like any other puzzle file
+    std::ofstream file(outputPath);
+    for (const MinedPuzzle& mined : result.puzzles) {
+        file << BitboardSolver::toBoard(mined.puzzle).toString() << '\n';
+    }
+    if (!file) {
+        std::cerr << "Could not write '" << outputPath << "'" << std::endl;
+        return 1;
+    }
+    
+    std::cerr << "Kept " << result.puzzles.size() << " puzzles from " << result.evaluations
+              << " evaluations and " << result.restarts << " restarts" << std::endl;
+    if (!result.puzzles.empty()) {
+        std::cerr << "Nodes (" << HardPuzzleMiner::getEngineName(options.engine) << "): max "
+                  << result.puzzles.front().nodes << ", min " << result.puzzles.back().nodes
+                  << std::endl;
+    }
+    return 0;
+}
+
+bool BatchTool::readLines(const std::string& path, std::vector<std::string>& lines) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            lines.push_back(line);
+        }
+    }
+    return true;
+}
+
+int BatchTool::parseThreads(const std::string& value) {
+    return std::max(1, std::atoi(value.c_str()));
+}
+
+bool BatchTool::parseDifficulties(const std::string& value, std::vector<Difficulty>& difficulties) {
+    std::vector<Difficulty> parsed;
+    std::stringstream stream(value);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        bool known = false;
+        for (int d = 0; d < 4; ++d) {
+            if (name == SudokuGenerator::getDifficultyName(static_cast<Difficulty>(d))) {
+                parsed.push_back(static_cast<Difficulty>(d));
+                known = true;
+            }
+        }
+        if (!known) {
+            return false;
+        }
+    }
+    if (parsed.empty()) {
+        return false;
+    }
+    difficulties = parsed;
+    return true;
+}
+
+bool BatchTool::parseVariant(const std::string& value, std::string& variant) {
+    if (value == "x" || value == "diagonal") {
+        variant = "diagonal";
+        return true;
+    }
+    if (value == "classic" || value == "hyper" || value == "jigsaw" || value == "killer") {
+        variant = value;
+        return true;
+    }
+    return false;
+}
+
+VariantPuzzle BatchTool::generateVariant(const std::string& variant, Difficulty difficulty,
+                                         const GeneratorOptions& options) {
+    if (variant == "jigsaw") {
+        return VariantGenerator::generateJigsaw(difficulty, options);
+    }
+    if (variant == "killer") {
+        return VariantGenerator::generateKiller(SudokuVariant::classic(), difficulty, options);
+    }
+    SudokuVariant rules = variant == "hyper" ? SudokuVariant::hyper()
+                        : variant == "diagonal" ? SudokuVariant::diagonal()
+                        : SudokuVariant::classic();
+    return VariantGenerator::generate(rules, difficulty, options);
+}
+
+std::string BatchTool::encodeVariant(const VariantPuzzle& puzzle) {
+    const int cells = Board::SIZE * Board::SIZE;
+    std::string text(cells, '0');
+    for (int i = 0; i < cells; ++i) {
+        text[i] = static_cast<char>('0' + puzzle.puzzle[i]);
+    }
+    
+    // Jigsaw regions follow the rows and columns among the units, 0-8 per cell
+    if (puzzle.variant.getName() == "jigsaw") {
+        std::string regions(cells, '0');
+        for (int region = 0; region < Board::SIZE; ++region) {
+            for (uint8_t cell : puzzle.variant.getUnit(2 * Board::SIZE + region)) {
+                regions[cell] = static_cast<char>('0' + region);
+            }
+        }
+        text += ' ' + regions;
+    }
+    // Each cage as sum=cell,cell,... with cells numbered 0-80 in row-major order
+    for (const Cage& cage : puzzle.variant.getCages()) {
+        text += ' ' + std::to_string(cage.sum) + '=';
+        for (size_t i = 0; i < cage.cells.size(); ++i) {
+            text += (i ? "," : "") + std::to_string(cage.cells[i]);
+        }
+    }
+    return text;
+}
+
+bool BatchTool::parseSymmetry(const std::string& value, Symmetry& symmetry) {
+    for (int s = 0; s <= static_cast<int>(Symmetry::MIRROR_BOTH); ++s) {
+        if (value == SudokuGenerator::getSymmetryName(static_cast<Symmetry>(s))) {
+            symmetry = static_cast<Symmetry>(s);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,33 @@
+//batchtool.h
+#pragma once
+
+#include "SudokuGenerator.h"
+#include "VariantGenerator.h"
+#include <string>
+#include <vector>
+
+// Headless commands run from the command line instead of opening the window
+class BatchTool {
+public:
+    // Returns the process exit code
+    static int run(int argc, char* argv[]);
+    
+private:
+    static int runDedup(const std::vector<std::string>& args);
+    static int runServe(const std::vector<std::string>& args);
+    static int runGenerate(const std::vector<std::string>& args);
+    static int runFuzz(const std::vector<std::string>& args);
+    static int runMine(const std::vector<std::string>& args);
+    static void printUsage();
+    
+    static bool readLines(const std::string& path, std::vector<std::string>& lines);
+    static int parseThreads(const std::string& value);
+    static bool parseDifficulties(const std::string& value, std::vector<Difficulty>& difficulties);
+    static bool parseSymmetry(const std::string& value, Symmetry& symmetry);
+    // classic, x (or diagonal), hyper, jigsaw or killer; x is stored as diagonal
+    static bool parseVariant(const std::string& value, std::string& variant);
+    static VariantPuzzle generateVariant(const std::string& variant, Difficulty difficulty,
+                                         const GeneratorOptions& options);
+    // The puzzle, then the jigsaw regions or the killer cages
+    static std::string encodeVariant(const VariantPuzzle& puzzle);
+};
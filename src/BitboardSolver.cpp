@@ -0,0 +1,319 @@
+//bitboard.cpp
+#include "BitboardSolver.h"
+#include "SudokuTables.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <vector>
+
+namespace {
+
+constexpr int N = Board::SIZE;
+constexpr int CELLS = N * N;
+constexpr uint16_t ALL_DIGITS = 0x1FF;
+
+constexpr std::array<uint8_t, 512> makePopcounts() {
+    std::array<uint8_t, 512> counts{};
+    for (int mask = 0; mask < 512; ++mask) {
+        for (int bit = mask; bit; bit &= bit - 1) {
+            counts[mask]++;
+        }
+    }
+    return counts;
+}
+
+constexpr std::array<uint8_t, 512> POPCOUNT = makePopcounts();
+
+using SudokuTables::ROW_OF;
+using SudokuTables::COL_OF;
+using SudokuTables::BOX_OF;
+
+} // namespace
+
+struct BitboardSolver::Search {
+    Grid cells;
+    std::array<uint16_t, N> rows{};
+    std::array<uint16_t, N> cols{};
+    std::array<uint16_t, N> boxes{};
+    
+    uint64_t maxSolutions = 1;
+    uint64_t count = 0;
+    Grid* firstSolution = nullptr;
+    const SearchLimits* limits = nullptr;
+    std::mt19937* rng = nullptr;
+    const SolutionVisitor* visitor = nullptr;
+    uint64_t nodes = 0;
+    uint64_t maxNodes = 0;  // 0 = no budget
+    bool aborted = false;
+    bool stopped = false; // limit reached or visitor asked to stop
+    
+    // Parallel enumeration: solutions are numbered across all tasks and a
+    // shared flag stops every task at once
+    std::atomic<uint64_t>* sharedCount = nullptr;
+    std::atomic<bool>* sharedStop = nullptr;
+    
+    bool load(const Grid& grid) {
+        cells = grid;
+        for (int i = 0; i < CELLS; ++i) {
+            int value = cells[i];
+            if (value == 0) continue;
+            if (value > N) return false;
+            
+            uint16_t bit = static_cast<uint16_t>(1 << (value - 1));
+            int r = ROW_OF[i];
+            int c = COL_OF[i];
+            int b = BOX_OF[i];
+            if ((rows[r] | cols[c] | boxes[b]) & bit) {
+                return false;
+            }
+            rows[r] |= bit;
+            cols[c] |= bit;
+            boxes[b] |= bit;
+        }
+        return true;
+    }
+    
+    // Most constrained empty cell, or -1 if the grid is full
+    int pickCell(uint16_t& bestMask) const {
+        int best = -1;
+        int bestCount = N + 1;
+        for (int i = 0; i < CELLS; ++i) {
+            if (cells[i] != 0) continue;
+            uint16_t mask = ALL_DIGITS & ~(rows[ROW_OF[i]] | cols[COL_OF[i]] | boxes[BOX_OF[i]]);
+            int candidates = POPCOUNT[mask];
+            if (candidates < bestCount) {
+                best = i;
+                bestCount = candidates;
+                bestMask = mask;
+                if (candidates <= 1) break;
+            }
+        }
+        return best;
+    }
+    
+    void place(int cell, int digit) {
+        uint16_t bit = static_cast<uint16_t>(1 << digit);
+        cells[cell] = static_cast<uint8_t>(digit + 1);
+        rows[ROW_OF[cell]] |= bit;
+        cols[COL_OF[cell]] |= bit;
+        boxes[BOX_OF[cell]] |= bit;
+    }
+    
+    void unplace(int cell, int digit) {
+        uint16_t bit = static_cast<uint16_t>(1 << digit);
+        cells[cell] = 0;
+        rows[ROW_OF[cell]] &= ~bit;
+        cols[COL_OF[cell]] &= ~bit;
+        boxes[BOX_OF[cell]] &= ~bit;
+    }
+    
+    void stop() {
+        stopped = true;
+        if (sharedStop) {
+            sharedStop->store(true, std::memory_order_relaxed);
+        }
+    }
+    
+    void visitSolution() {
+        // Parallel tasks number their solutions together; one past the limit
+        // means another task got there first
+        uint64_t number = sharedCount ? sharedCount->fetch_add(1) + 1 : count + 1;
+        if (number > maxSolutions) {
+            stop();
+            return;
+        }
+        if (count == 0 && firstSolution) {
+            *firstSolution = cells;
+        }
+        count++;
+        if ((visitor && !(*visitor)(cells)) || number >= maxSolutions) {
+            stop();
+        }
+    }
+    
+    void run() {
+        ++nodes;
+        if ((limits && nodes % SearchLimits::NODES_PER_CHECK == 0 && limits->shouldStop()) ||
+            (maxNodes != 0 && nodes > maxNodes)) {
+            aborted = true;
+            return;
+        }
+        if (sharedStop && sharedStop->load(std::memory_order_relaxed)) {
+            stopped = true;
+            return;
+        }
+        
+        uint16_t mask = 0;
+        int best = pickCell(mask);
+        if (best == -1) {
+            visitSolution();
+            return;
+        }
+        
+        int digits[N];
+        int digitCount = 0;
+        for (int d = 0; d < N; ++d) {
+            if (mask & (1 << d)) {
+                digits[digitCount++] = d;
+            }
+        }
+        if (rng) {
+            std::shuffle(digits, digits + digitCount, *rng);
+        }
+        
+        for (int k = 0; k < digitCount; ++k) {
+            place(best, digits[k]);
+            run();
+            unplace(best, digits[k]);
+            if (stopped || aborted) {
+                return;
+            }
+        }
+    }
+};
+
+BitboardSolver::Grid BitboardSolver::fromBoard(const Board& board) {
+    Grid grid;
+    for (int r = 0; r < N; ++r) {
+        for (int c = 0; c < N; ++c) {
+            grid[r * N + c] = static_cast<uint8_t>(board.getValue(r, c));
+        }
+    }
+    return grid;
+}
+
+Board BitboardSolver::toBoard(const Grid& grid) {
+    Board board;
+    for (int r = 0; r < N; ++r) {
+        for (int c = 0; c < N; ++c) {
+            int value = grid[r * N + c];
+            board.setValue(r, c, value);
+            board.getCell(r, c).setGiven(value != 0);
+        }
+    }
+    return board;
+}
+
+int BitboardSolver::countSolutions(const Grid& grid, int maxSolutions, Grid* firstSolution,
+                                   const SearchLimits* limits, uint64_t* nodes) {
+    if (nodes) {
+        *nodes = 0;
+    }
+    Search search;
+    if (!search.load(grid)) {
+        return 0;
+    }
+    search.maxSolutions = static_cast<uint64_t>(std::max(maxSolutions, 1));
+    search.firstSolution = firstSolution;
+    search.limits = limits;
+    search.run();
+    
+    if (nodes) {
+        *nodes = search.nodes;
+    }
+    return search.aborted ? -1 : static_cast<int>(search.count);
+}
+
+bool BitboardSolver::hasUniqueSolution(const Grid& grid) {
+    return countSolutions(grid, 2) == 1;
+}
+
+bool BitboardSolver::randomFill(Grid& grid, std::mt19937& rng, uint64_t maxNodes) {
+    Search search;
+    if (!search.load(grid)) {
+        return false;
+    }
+    search.rng = &rng;
+    search.maxNodes = maxNodes;
+    search.firstSolution = &grid;
+    search.run();
+    return search.count > 0;
+}
+
+EnumerationResult BitboardSolver::enumerate(const Grid& grid, uint64_t limit,
+                                            const SolutionVisitor& visitor,
+                                            const SearchLimits* limits) {
+    EnumerationResult result{0, false, false};
+    Search search;
+    if (limit == 0 || !search.load(grid)) {
+        return result;
+    }
+    search.maxSolutions = limit;
+    search.limits = limits;
+    search.visitor = visitor ? &visitor : nullptr;
+    search.run();
+    
+    result.solutions = search.count;
+    result.stopped = search.stopped;
+    result.aborted = search.aborted;
+    return result;
+}
+
+EnumerationResult BitboardSolver::enumerate(const Grid& grid, uint64_t limit, ThreadPool& pool,
+                                            const SolutionVisitor& visitor,
+                                            const SearchLimits* limits) {
+    EnumerationResult result{0, false, false};
+    Search root;
+    if (limit == 0 || !root.load(grid)) {
+        return result;
+    }
+    
+    // Expand the shallowest branches breadth-first until there are enough
+    // independent subtrees to keep every worker busy
+    size_t wanted = static_cast<size_t>(pool.getThreadCount()) * ENUMERATION_TASKS_PER_THREAD;
+    std::vector<Grid> frontier = {grid};
+    for (int depth = 0; depth < ENUMERATION_MAX_SPLIT_DEPTH && frontier.size() < wanted; ++depth) {
+        std::vector<Grid> next;
+        bool expanded = false;
+        for (const Grid& state : frontier) {
+            Search search;
+            search.load(state);
+            uint16_t mask = 0;
+            int cell = search.pickCell(mask);
+            if (cell == -1) {
+                next.push_back(state); // already a solution
+                continue;
+            }
+            expanded = true;
+            for (int d = 0; d < N; ++d) {
+                if (mask & (1 << d)) {
+                    search.place(cell, d);
+                    next.push_back(search.cells);
+                    search.unplace(cell, d);
+                }
+            }
+        }
+        frontier.swap(next);
+        if (!expanded) break;
+    }
+    
+    std::atomic<uint64_t> sharedCount(0);
+    std::atomic<bool> sharedStop(false);
+    std::atomic<bool> aborted(false);
+    std::vector<std::future<void>> tasks;
+    for (const Grid& state : frontier) {
+        tasks.push_back(pool.submit([&, state]() {
+            if (sharedStop.load(std::memory_order_relaxed)) return;
+            Search search;
+            search.load(state);
+            search.maxSolutions = limit;
+            search.limits = limits;
+            search.visitor = visitor ? &visitor : nullptr;
+            search.sharedCount = &sharedCount;
+            search.sharedStop = &sharedStop;
+            search.run();
+            if (search.aborted) {
+                aborted = true;
+                sharedStop = true;
+            }
+        }));
+    }
+    for (auto& task : tasks) {
+        task.get();
+    }
+    
+    result.solutions = std::min(sharedCount.load(), limit);
+    result.aborted = aborted;
+    result.stopped = !result.aborted && sharedStop;
+    return result;
+}
@@ -0,0 +1,63 @@
+//bitboard.h
+#pragma once
+
+#include "Board.h"
+#include "CancellationToken.h"
+#include "ThreadPool.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <random>
+
+struct EnumerationResult {
+    uint64_t solutions;   // solutions visited
+    // The limit-th solution was visited or the visitor asked to stop. Both
+    // overloads stop right after that visit, so a search that finds exactly
+    // limit solutions reports stopped without exploring the rest.
+    bool stopped;
+    bool aborted;         // the search limits were hit
+};
+
+// Allocation-free solver over an 81-byte grid for throughput-bound work.
+// Row, column and box usage are 9-bit masks and the search always
+// branches on the cell with the fewest candidates.
+class BitboardSolver {
+public:
+    using Grid = std::array<uint8_t, Board::SIZE * Board::SIZE>;
+    // Receives each solution as an 81-byte view valid only during the call;
+    // returning false stops the enumeration
+    using SolutionVisitor = std::function<bool(const Grid&)>;
+    
+    static constexpr size_t ENUMERATION_TASKS_PER_THREAD = 16;
+    static constexpr int ENUMERATION_MAX_SPLIT_DEPTH = 8;
+    
+    static Grid fromBoard(const Board& board);
+    // Filled cells become givens
+    static Board toBoard(const Grid& grid);
+    
+    // Returns the number of solutions found, stopping at maxSolutions, or -1
+    // if the limits stopped the search. Contradictory givens count as zero.
+    // nodes, when given, is set to the number of search nodes visited.
+    static int countSolutions(const Grid& grid, int maxSolutions,
+                              Grid* firstSolution = nullptr,
+                              const SearchLimits* limits = nullptr,
+                              uint64_t* nodes = nullptr);
+    static bool hasUniqueSolution(const Grid& grid);
+    
+    // Completes the grid trying digits in an order drawn from rng, giving
+    // up after maxNodes (0 = no limit)
+    static bool randomFill(Grid& grid, std::mt19937& rng, uint64_t maxNodes = 0);
+    
+    // Visits every solution, up to limit; pass an empty visitor to only count
+    static EnumerationResult enumerate(const Grid& grid, uint64_t limit,
+                                       const SolutionVisitor& visitor,
+                                       const SearchLimits* limits = nullptr);
+    // Parallel across subtrees; the visitor is called concurrently from pool
+    // threads and solutions arrive in no particular order
+    static EnumerationResult enumerate(const Grid& grid, uint64_t limit, ThreadPool& pool,
+                                       const SolutionVisitor& visitor,
+                                       const SearchLimits* limits = nullptr);
+    
+private:
+    struct Search;
+};
@@ -1,27 +1,60 @@
 //board.cpp
 #include "Board.h"
 
+namespace {
+
+constexpr int CELL_COUNT = Board::SIZE * Board::SIZE;
+
+constexpr uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// One key per (cell, value); empty cells hash to zero so a blank board is 0
+constexpr std::array<uint64_t, CELL_COUNT * 10> makeZobristKeys() {
+    std::array<uint64_t, CELL_COUNT * 10> keys{};
+    uint64_t state = 0x5D0C0B0A12345678ULL;
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        for (int value = 1; value <= 9; ++value) {
+            keys[cell * 10 + value] = splitmix64(state);
+        }
+    }
+    return keys;
+}
+
+constexpr std::array<uint64_t, CELL_COUNT * 10> ZOBRIST_KEYS = makeZobristKeys();
+
+uint64_t zobristKey(int row, int col, int value) {
+    return ZOBRIST_KEYS[(row * Board::SIZE + col) * 10 + value];
+}
+
+} // namespace
+
 Board::Board() {
     clear();
 }
 
 Cell& Board::getCell(int row, int col) {
-    return cells_[row][col];
+    return cells_[row * SIZE + col];
 }
 
 const Cell& Board::getCell(int row, int col) const {
-    return cells_[row][col];
+    return cells_[row * SIZE + col];
 }
 
 void Board::setValue(int row, int col, int value) {
-    if (row >= 0 && row < SIZE && col >= 0 && col < SIZE) {
-        cells_[row][col].setValue(value);
+    if (row >= 0 && row < SIZE && col >= 0 && col < SIZE && value >= 0 && value <= SIZE) {
+        Cell& cell = cells_[row * SIZE + col];
+        hash_ ^= zobristKey(row, col, cell.getValue()) ^ zobristKey(row, col, value);
+        cell.setValue(value);
     }
 }
 
 int Board::getValue(int row, int col) const {
     if (row >= 0 && row < SIZE && col >= 0 && col < SIZE) {
-        return cells_[row][col].getValue();
+        return cells_[row * SIZE + col].getValue();
     }
     return 0;
 }
@@ -29,39 +62,19 @@ int Board::getValue(int row, int col) const {
 bool Board::isValidPlacement(int row, int col, int value) const {
     if (value < 1 || value > 9) return false;
     
-    // Check row
-    for (int c = 0; c < SIZE; ++c) {
-        if (c != col && cells_[row][c].getValue() == value) {
-            return false;
-        }
-    }
-    
-    // Check column
-    for (int r = 0; r < SIZE; ++r) {
-        if (r != row && cells_[r][col].getValue() == value) {
+    for (uint8_t peer : SudokuTables::PEERS[row * SIZE + col]) {
+        if (cells_[peer].getValue() == value) {
             return false;
         }
     }
-    
-    // Check 3x3 box
-    int boxRow = (row / BOX_SIZE) * BOX_SIZE;
-    int boxCol = (col / BOX_SIZE) * BOX_SIZE;
-    
-    for (int r = boxRow; r < boxRow + BOX_SIZE; ++r) {
-        for (int c = boxCol; c < boxCol + BOX_SIZE; ++c) {
-            if (r != row && c != col && cells_[r][c].getValue() == value) {
-                return false;
-            }
-        }
-    }
-    
     return true;
 }
 
 bool Board::isComplete() const {
     for (int r = 0; r < SIZE; ++r) {
         for (int c = 0; c < SIZE; ++c) {
-            if (cells_[r][c].isEmpty() || !isValidPlacement(r, c, cells_[r][c].getValue())) {
+            const Cell& cell = cells_[r * SIZE + c];
+            if (cell.isEmpty() || !isValidPlacement(r, c, cell.getValue())) {
                 return false;
             }
         }
@@ -70,32 +83,51 @@ bool Board::isComplete() const {
 }
 
 void Board::clear() {
-    for (int r = 0; r < SIZE; ++r) {
-        for (int c = 0; c < SIZE; ++c) {
-            cells_[r][c] = Cell();
-        }
-    }
+    cells_.fill(Cell());
+    hash_ = 0;
 }
 
 void Board::copyFrom(const Board& other) {
+    cells_ = other.cells_;
+    hash_ = other.hash_;
+}
+
+uint64_t Board::getHash() const {
+    return hash_;
+}
+
+const SudokuTables::Unit& Board::getBoxCells(int boxRow, int boxCol) {
+    return SudokuTables::UNITS[2 * SIZE + boxRow * BOX_SIZE + boxCol];
+}
+
+std::string Board::toString() const {
+    std::string text(SIZE * SIZE, '0');
     for (int r = 0; r < SIZE; ++r) {
         for (int c = 0; c < SIZE; ++c) {
-            cells_[r][c] = other.cells_[r][c];
+            text[r * SIZE + c] = static_cast<char>('0' + cells_[r * SIZE + c].getValue());
         }
     }
+    return text;
 }
 
-std::vector<std::pair<int, int>> Board::getBoxCells(int boxRow, int boxCol) const {
-    std::vector<std::pair<int, int>> cells;
-    int startRow = boxRow * BOX_SIZE;
-    int startCol = boxCol * BOX_SIZE;
+bool Board::fromString(const std::string& text, Board& board) {
+    if (text.size() < SIZE * SIZE) {
+        return false;
+    }
     
-    for (int r = startRow; r < startRow + BOX_SIZE; ++r) {
-        for (int c = startCol; c < startCol + BOX_SIZE; ++c) {
-            cells.emplace_back(r, c);
+    Board parsed;
+    for (int i = 0; i < SIZE * SIZE; ++i) {
+        char ch = text[i];
+        int value = 0;
+        if (ch >= '1' && ch <= '9') {
+            value = ch - '0';
+        } else if (ch != '0' && ch != '.') {
+            return false;
         }
+        parsed.setValue(SudokuTables::ROW_OF[i], SudokuTables::COL_OF[i], value);
+        parsed.cells_[i].setGiven(value != 0);
     }
     
-    return cells;
+    board = parsed;
+    return true;
 }
-
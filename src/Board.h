@@ -2,13 +2,17 @@
 #pragma once
 
 #include "Cell.h"
+#include "SudokuTables.h"
 #include <array>
-#include <vector>
+#include <cstdint>
+#include <string>
 
 class Board {
 public:
     static constexpr int SIZE = 9;
     static constexpr int BOX_SIZE = 3;
+    static_assert(SIZE == SudokuTables::SIZE && BOX_SIZE == SudokuTables::BOX_SIZE,
+                  "lookup tables are built for 9x9 boards");
     
     Board();
     
@@ -24,9 +28,20 @@ public:
     void clear();
     void copyFrom(const Board& other);
     
-    std::vector<std::pair<int, int>> getBoxCells(int boxRow, int boxCol) const;
+    // Zobrist hash of the cell values, kept up to date by setValue.
+    // Values changed directly through getCell() are not tracked.
+    uint64_t getHash() const;
+    
+    // Cell indices (row * SIZE + col) of the box, from SudokuTables::UNITS
+    static const SudokuTables::Unit& getBoxCells(int boxRow, int boxCol);
+    
+    // 81 characters in row-major order, '0' for empty cells
+    std::string toString() const;
+    // Accepts '0' or '.' for empty cells; filled cells become givens
+    static bool fromString(const std::string& text, Board& board);
     
 private:
-    std::array<std::array<Cell, SIZE>, SIZE> cells_;
+    std::array<Cell, SIZE * SIZE> cells_;  // row-major
+    uint64_t hash_;
 };
 
@@ -0,0 +1,23 @@
+//cancellation.cpp
+#include "CancellationToken.h"
+
+CancellationToken::CancellationToken() : cancelled_(false) {
+}
+
+void CancellationToken::cancel() {
+    cancelled_.store(true, std::memory_order_relaxed);
+}
+
+bool CancellationToken::isCancelled() const {
+    return cancelled_.load(std::memory_order_relaxed);
+}
+
+bool SearchLimits::shouldStop() const {
+    if (token && token->isCancelled()) {
+        return true;
+    }
+    if (parent && parent->shouldStop()) {
+        return true;
+    }
+    return deadline && std::chrono::steady_clock::now() >= *deadline;
+}
@@ -0,0 +1,32 @@
+//cancellation.h
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+// Shared flag another thread can raise to stop a running search
+class CancellationToken {
+public:
+    CancellationToken();
+    
+    void cancel();
+    bool isCancelled() const;
+    
+private:
+    std::atomic<bool> cancelled_;
+};
+
+// When a long search must give up: a cancellation token, a deadline or both.
+// A parent lets an internal stop condition also honour the caller's limits.
+struct SearchLimits {
+    const CancellationToken* token = nullptr;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    const SearchLimits* parent = nullptr;
+    
+    // Every solver polls shouldStop() once per this many search nodes
+    static constexpr uint64_t NODES_PER_CHECK = 4096;
+    
+    bool shouldStop() const;
+};
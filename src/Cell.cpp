@@ -1,7 +1,7 @@
 //cell.cpp
 #include "Cell.h"
 
-Cell::Cell() : value_(0), isGiven_(false), hasError_(false) {
+Cell::Cell() : value_(0), isGiven_(false), notes_(0), hasError_(false) {
 }
 
 void Cell::setValue(int value) {
@@ -29,26 +29,34 @@ void Cell::setGiven(bool given) {
 
 void Cell::addNote(int value) {
     if (value >= 1 && value <= 9 && isEmpty()) {
-        notes_.insert(value);
+        notes_ |= static_cast<uint16_t>(1 << (value - 1));
     }
 }
 
 void Cell::removeNote(int value) {
-    notes_.erase(value);
+    if (value >= 1 && value <= 9) {
+        notes_ &= static_cast<uint16_t>(~(1 << (value - 1)));
+    }
 }
 
 void Cell::clearNotes() {
-    notes_.clear();
+    notes_ = 0;
 }
 
 bool Cell::hasNote(int value) const {
-    return notes_.find(value) != notes_.end();
+    return value >= 1 && value <= 9 && (notes_ & (1 << (value - 1)));
 }
 
-const std::set<int>& Cell::getNotes() const {
+uint16_t Cell::getNotes() const {
     return notes_;
 }
 
+void Cell::setNotes(uint16_t notes) {
+    if (isEmpty()) {
+        notes_ = notes & 0x1FF;
+    }
+}
+
 void Cell::setError(bool error) {
     hasError_ = error;
 }
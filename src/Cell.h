@@ -1,7 +1,7 @@
 //cell.h
 #pragma once
 
-#include <set>
+#include <cstdint>
 
 class Cell {
 public:
@@ -17,7 +17,9 @@ public:
     void removeNote(int value);
     void clearNotes();
     bool hasNote(int value) const;
-    const std::set<int>& getNotes() const;
+    // Bit value-1 is set for each pencil mark
+    uint16_t getNotes() const;
+    void setNotes(uint16_t notes);
     
     void setError(bool error);
     bool hasError() const;
@@ -25,7 +27,7 @@ public:
 private:
     int value_;           // 0 means empty
     bool isGiven_;        // true if this was part of the initial puzzle
-    std::set<int> notes_; // pencil marks
+    uint16_t notes_;      // pencil marks
     bool hasError_;
 };
 
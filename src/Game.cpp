@@ -1,22 +1,152 @@
 //game.cpp
 #include "Game.h"
+#include "SudokuTransformer.h"
 #include <algorithm>
+#include <random>
 
-Game::Game() 
+namespace {
+
+constexpr int CELL_COUNT = SudokuTables::CELL_COUNT;
+constexpr int PEER_COUNT = SudokuTables::PEER_COUNT;
+
+using SudokuTables::ROW_OF;
+using SudokuTables::COL_OF;
+using SudokuTables::CELL_UNITS;
+using SudokuTables::PEERS;
+
+// Snapshot layout, little-endian:
+//   0   4  magic "SDKS"
+//   4   1  version
+//   5   1  difficulty
+//   6   1  hints remaining
+//   7   1  flags: bit 0 notes mode, bit 1 auto notes
+//   8   4  elapsed seconds
+//   12  41 values, two cells per byte, high nibble first
+//   53  41 solution, same packing
+//   94  11 givens, bit i % 8 of byte i / 8
+//   105 92 notes, 9 bits per cell from bit 0 of byte 0
+//   197 4  FNV-1a of everything before it
+constexpr uint8_t SNAPSHOT_MAGIC[4] = {'S', 'D', 'K', 'S'};
+constexpr size_t VALUES_OFFSET = 12;
+constexpr size_t SOLUTION_OFFSET = 53;
+constexpr size_t GIVENS_OFFSET = 94;
+constexpr size_t NOTES_OFFSET = 105;
+constexpr size_t CHECKSUM_OFFSET = 197;
+constexpr int NOTE_BITS = 9;
+
+uint32_t checksum(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void put32(uint8_t* out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+uint32_t get32(const uint8_t* in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+int getNibble(const uint8_t* packed, int cell) {
+    return cell % 2 == 0 ? packed[cell / 2] >> 4 : packed[cell / 2] & 0xF;
+}
+
+void putNibble(uint8_t* packed, int cell, int value) {
+    packed[cell / 2] |= static_cast<uint8_t>(cell % 2 == 0 ? value << 4 : value);
+}
+
+// Medium puzzles and their solutions, so the first game needs neither the
+// generator nor a solve before the window can draw. Each start shows a
+// random transform of one of them.
+constexpr const char* STARTUP_PUZZLES[][2] = {
+    {"510030900007009000000054016040900350030840000605371090002090603306010020000063185",
+     "518632974467189532293754816841926357739845261625371498182597643356418729974263185"},
+    {"000610002700000504002007060500002793300760040000030050670083109080276405000109607",
+     "853614972769328514142597368516842793398765241427931856675483129981276435234159687"},
+    {"000856000153027600060130400006084000000090100009010864030960002690270008827000030",
+     "942856371153427689768139425516784293384692157279315864435968712691273548827541936"},
+    {"302100000000674008000000719039000004140536000206800100420003675590067000000051903",
+     "372198456915674328684325719839712564147536892256849137421983675593467281768251943"}
+};
+
+} // namespace
+
+static_assert(Game::SNAPSHOT_SIZE == CHECKSUM_OFFSET + 4, "snapshot layout and size disagree");
+static_assert(NOTES_OFFSET + (CELL_COUNT * NOTE_BITS + 7) / 8 == CHECKSUM_OFFSET,
+              "notes do not fit the snapshot layout");
+
+Game::Game()
+    : Game(std::string()) {
+}
+
+Game::Game(const std::string& savePath)
     : currentDifficulty_(Difficulty::MEDIUM)
     , selectedCell_({-1, -1})
     , notesMode_(false)
     , hintsRemaining_(3)
     , paused_(false)
     , accumulatedPauseTime_(0)
-    , totalElapsedSeconds_(0) {
-    newGame(Difficulty::MEDIUM);
+    , totalElapsedSeconds_(0)
+    , autoNotes_(false)
+    , filledCells_(0)
+    , conflicts_(0)
+    , moveCell_(-1)
+    , autoSolving_(false) {
+    // A finished game is not worth resuming
+    std::vector<uint8_t> saved;
+    if (savePath.empty() || !AutoSaver::read(savePath, saved) || !loadSnapshot(saved) ||
+        isComplete()) {
+        startupGame();
+    }
+    if (!savePath.empty()) {
+        autoSaver_ = std::make_unique<AutoSaver>(savePath);
+        autosave();
+    }
 }
 
 void Game::newGame(Difficulty difficulty) {
+    // Removal trials spread over every core; the puzzle is the same either way.
+    // Expert searches for a minimal puzzle on every core instead, since a
+    // single greedy pass stops well above its clue target.
+    GeneratorOptions options;
+    options.threads = 0;
+    options.minimalSearch = difficulty == Difficulty::EXPERT;
+    CancellationToken token;
+    GenerationResult generated = SudokuGenerator::generate(
+        difficulty, options, std::chrono::steady_clock::now() + EXPERT_SEARCH_TIME, token);
+    board_ = generated.puzzle;
+    solution_ = generated.solution;
+    beginGame(difficulty);
+}
+
+void Game::startupGame() {
+    std::random_device rd;
+    std::mt19937 rng(rd());
+    size_t count = sizeof(STARTUP_PUZZLES) / sizeof(STARTUP_PUZZLES[0]);
+    const auto& entry = STARTUP_PUZZLES[std::uniform_int_distribution<size_t>(0, count - 1)(rng)];
+    Board::fromString(entry[0], board_);
+    Board::fromString(entry[1], solution_);
+    SudokuTransformer::randomize(board_, solution_, rng);
+    beginGame(Difficulty::MEDIUM);
+}
+
+void Game::beginGame(Difficulty difficulty) {
     currentDifficulty_ = difficulty;
-    board_ = SudokuGenerator::generate(difficulty);
-    generateSolution();
+    autoSolving_ = false;
+    autoSolver_.reset();
+    resetCandidates();
+    journal_.clear();
+    lastHint_ = Hint();
     
     selectedCell_ = {-1, -1};
     notesMode_ = false;
@@ -25,15 +155,11 @@ void Game::newGame(Difficulty difficulty) {
     accumulatedPauseTime_ = 0;
     totalElapsedSeconds_ = 0;
     startTime_ = std::chrono::steady_clock::now();
-}
-
-void Game::generateSolution() {
-    solution_ = board_;
-    SudokuSolver::solve(solution_);
+    autosave();
 }
 
 void Game::setValue(int row, int col, int value) {
-    if (row < 0 || row >= Board::SIZE || col < 0 || col >= Board::SIZE) {
+    if (row < 0 || row >= Board::SIZE || col < 0 || col >= Board::SIZE || autoSolving_) {
         return;
     }
     
@@ -42,6 +168,7 @@ void Game::setValue(int row, int col, int value) {
         return; // Cannot modify given cells
     }
     
+    beginMove(row, col);
     if (notesMode_) {
         if (cell.hasNote(value)) {
             cell.removeNote(value);
@@ -49,42 +176,78 @@ void Game::setValue(int row, int col, int value) {
             cell.addNote(value);
         }
     } else {
-        cell.setValue(value);
-        cell.clearNotes();
-        checkErrors();
+        removeDigit(row, col);
+        placeDigit(row, col, value);
+        refreshErrors(row * Board::SIZE + col);
     }
+    endMove();
+    autosave();
 }
 
 void Game::setNote(int row, int col, int value) {
-    if (row < 0 || row >= Board::SIZE || col < 0 || col >= Board::SIZE) {
+    if (row < 0 || row >= Board::SIZE || col < 0 || col >= Board::SIZE || autoSolving_) {
         return;
     }
     
     Cell& cell = board_.getCell(row, col);
     if (!cell.isGiven() && cell.isEmpty()) {
+        beginMove(row, col);
         if (cell.hasNote(value)) {
             cell.removeNote(value);
         } else {
             cell.addNote(value);
         }
+        endMove();
+        autosave();
     }
 }
 
 void Game::clearCell(int row, int col) {
-    if (row < 0 || row >= Board::SIZE || col < 0 || col >= Board::SIZE) {
+    if (row < 0 || row >= Board::SIZE || col < 0 || col >= Board::SIZE || autoSolving_) {
         return;
     }
     
     Cell& cell = board_.getCell(row, col);
     if (!cell.isGiven()) {
-        cell.setValue(0);
+        beginMove(row, col);
         cell.clearNotes();
-        cell.setError(false);
+        removeDigit(row, col);
+        refreshErrors(row * Board::SIZE + col);
+        endMove();
+        autosave();
+    }
+}
+
+void Game::undo() {
+    MoveJournal::Move move;
+    size_t count = autoSolving_ ? 0 : journal_.undo(move);
+    if (count > 0) {
+        lastHint_ = Hint();
+        applyMove(move, count, true);
+        autosave();
     }
 }
 
+void Game::redo() {
+    MoveJournal::Move move;
+    size_t count = autoSolving_ ? 0 : journal_.redo(move);
+    if (count > 0) {
+        lastHint_ = Hint();
+        applyMove(move, count, false);
+        autosave();
+    }
+}
+
+bool Game::canUndo() const {
+    return journal_.canUndo();
+}
+
+bool Game::canRedo() const {
+    return journal_.canRedo();
+}
+
 bool Game::isComplete() const {
-    return board_.isComplete();
+    return filledCells_ == CELL_COUNT && conflicts_ == 0;
 }
 
 bool Game::isPaused() const {
@@ -95,6 +258,7 @@ void Game::pause() {
     if (!paused_) {
         paused_ = true;
         pauseStartTime_ = std::chrono::steady_clock::now();
+        autosave();
     }
 }
 
@@ -146,24 +310,41 @@ int Game::getElapsedSeconds() const {
 }
 
 void Game::useHint() {
-    if (hintsRemaining_ <= 0) {
+    if (hintsRemaining_ <= 0 || autoSolving_) {
         return;
     }
     
-    if (selectedCell_.first == -1 || selectedCell_.second == -1) {
+    Hint hint = getHint();
+    if (hint.technique == HintTechnique::CONFLICT) {
+        selectedCell_ = {ROW_OF[hint.cell], COL_OF[hint.cell]};
+        lastHint_ = hint;
         return;
     }
     
     int row = selectedCell_.first;
     int col = selectedCell_.second;
+    if (hint.technique != HintTechnique::NONE &&
+        solution_.getValue(ROW_OF[hint.cell], COL_OF[hint.cell]) == hint.value) {
+        row = ROW_OF[hint.cell];
+        col = COL_OF[hint.cell];
+    } else {
+        hint = Hint();
+    }
+    if (row == -1 || col == -1) {
+        return;
+    }
     
     Cell& cell = board_.getCell(row, col);
     if (!cell.isGiven() && cell.isEmpty()) {
         int correctValue = solution_.getValue(row, col);
-        cell.setValue(correctValue);
-        cell.clearNotes();
-        cell.setError(false);
+        beginMove(row, col);
+        placeDigit(row, col, correctValue);
+        refreshErrors(row * Board::SIZE + col);
+        endMove();
+        selectedCell_ = {row, col};
+        lastHint_ = hint;
         hintsRemaining_--;
+        autosave();
     }
 }
 
@@ -171,14 +352,81 @@ int Game::getHintsRemaining() const {
     return hintsRemaining_;
 }
 
+Hint Game::getHint() const {
+    HintEngine::Grid values;
+    HintEngine::Candidates candidates;
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        values[cell] = static_cast<uint8_t>(board_.getValue(ROW_OF[cell], COL_OF[cell]));
+        candidates[cell] = getCandidates(ROW_OF[cell], COL_OF[cell]);
+    }
+    return HintEngine::findHint(values, candidates);
+}
+
+const Hint& Game::getLastHint() const {
+    return lastHint_;
+}
+
 void Game::toggleNotesMode() {
     notesMode_ = !notesMode_;
+    autosave();
 }
 
 bool Game::isNotesMode() const {
     return notesMode_;
 }
 
+void Game::toggleAutoNotes() {
+    autoNotes_ = !autoNotes_;
+    if (autoNotes_) {
+        fillAutoNotes();
+        journal_.clear();
+    }
+    autosave();
+}
+
+bool Game::isAutoNotes() const {
+    return autoNotes_;
+}
+
+void Game::toggleAutoSolve() {
+    autoSolving_ = !autoSolving_;
+    if (autoSolving_) {
+        autoSolver_.start(board_);
+    } else {
+        autoSolver_.reset();
+    }
+}
+
+bool Game::isAutoSolving() const {
+    return autoSolving_;
+}
+
+void Game::updateAutoSolve() {
+    if (!autoSolving_ || paused_) {
+        return;
+    }
+    
+    // One placement per frame to start, speeding up the longer the search
+    // runs so that hard puzzles still finish within seconds
+    uint64_t nodes = 1 + autoSolver_.getNodes() / AUTO_SOLVE_SPEEDUP;
+    IncrementalSolver::State state = autoSolver_.step(nodes, AUTO_SOLVE_FRAME_BUDGET);
+    
+    if (state == IncrementalSolver::State::SOLVED) {
+        board_ = autoSolver_.getBoard();
+        resetCandidates();
+        checkErrors();
+        journal_.clear();
+        autoSolving_ = false;
+        autosave();
+    } else if (state != IncrementalSolver::State::RUNNING) {
+        autoSolving_ = false;
+    }
+}
+
+const IncrementalSolver& Game::getAutoSolver() const {
+    return autoSolver_;
+}
+
 void Game::selectCell(int row, int col) {
     if (row >= 0 && row < Board::SIZE && col >= 0 && col < Board::SIZE) {
         selectedCell_ = {row, col};
@@ -200,16 +448,304 @@ const Board& Game::getBoard() const {
 }
 
 void Game::checkErrors() {
-    for (int r = 0; r < Board::SIZE; ++r) {
-        for (int c = 0; c < Board::SIZE; ++c) {
-            Cell& cell = board_.getCell(r, c);
-            if (!cell.isEmpty()) {
-                bool isValid = board_.isValidPlacement(r, c, cell.getValue());
-                cell.setError(!isValid);
-            } else {
-                cell.setError(false);
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        board_.getCell(ROW_OF[cell], COL_OF[cell]).setError(hasConflict(cell));
+    }
+}
+
+std::vector<uint8_t> Game::saveSnapshot() const {
+    std::vector<uint8_t> data(SNAPSHOT_SIZE, 0);
+    std::copy(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + 4, data.begin());
+    data[4] = SNAPSHOT_VERSION;
+    data[5] = static_cast<uint8_t>(currentDifficulty_);
+    data[6] = static_cast<uint8_t>(hintsRemaining_);
+    data[7] = static_cast<uint8_t>((notesMode_ ? 1 : 0) | (autoNotes_ ? 2 : 0));
+    put32(&data[8], static_cast<uint32_t>(std::max(totalElapsedSeconds_, 0)));
+    
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        const Cell& c = board_.getCell(ROW_OF[cell], COL_OF[cell]);
+        putNibble(&data[VALUES_OFFSET], cell, c.getValue());
+        putNibble(&data[SOLUTION_OFFSET], cell, solution_.getValue(ROW_OF[cell], COL_OF[cell]));
+        if (c.isGiven()) {
+            data[GIVENS_OFFSET + cell / 8] |= static_cast<uint8_t>(1 << (cell % 8));
+        }
+        uint16_t notes = c.getNotes();
+        for (int b = 0; b < NOTE_BITS; ++b) {
+            if (notes & (1 << b)) {
+                int bit = cell * NOTE_BITS + b;
+                data[NOTES_OFFSET + bit / 8] |= static_cast<uint8_t>(1 << (bit % 8));
             }
         }
     }
+    
+    put32(&data[CHECKSUM_OFFSET], checksum(data.data(), CHECKSUM_OFFSET));
+    return data;
 }
 
+bool Game::loadSnapshot(const std::vector<uint8_t>& data) {
+    if (data.size() != SNAPSHOT_SIZE || !std::equal(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + 4, data.begin()) ||
+        data[4] != SNAPSHOT_VERSION || get32(&data[CHECKSUM_OFFSET]) != checksum(data.data(), CHECKSUM_OFFSET) ||
+        data[5] > static_cast<uint8_t>(Difficulty::EXPERT) || data[6] > 3) {
+        return false;
+    }
+    
+    Board board;
+    Board solution;
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        int row = ROW_OF[cell];
+        int col = COL_OF[cell];
+        int value = getNibble(&data[VALUES_OFFSET], cell);
+        int solved = getNibble(&data[SOLUTION_OFFSET], cell);
+        bool given = (data[GIVENS_OFFSET + cell / 8] >> (cell % 8)) & 1;
+        if (value > Board::SIZE || solved < 1 || solved > Board::SIZE ||
+            (given && value != solved)) {
+            return false;
+        }
+        
+        uint16_t notes = 0;
+        for (int b = 0; b < NOTE_BITS; ++b) {
+            int bit = cell * NOTE_BITS + b;
+            if ((data[NOTES_OFFSET + bit / 8] >> (bit % 8)) & 1) {
+                notes |= static_cast<uint16_t>(1 << b);
+            }
+        }
+        
+        board.setValue(row, col, value);
+        board.getCell(row, col).setGiven(given);
+        board.getCell(row, col).setNotes(notes);
+        solution.setValue(row, col, solved);
+        solution.getCell(row, col).setGiven(given);
+    }
+    if (!solution.isComplete()) {
+        return false;
+    }
+    
+    autoSolving_ = false;
+    autoSolver_.reset();
+    board_ = board;
+    solution_ = solution;
+    currentDifficulty_ = static_cast<Difficulty>(data[5]);
+    hintsRemaining_ = data[6];
+    notesMode_ = (data[7] & 1) != 0;
+    autoNotes_ = (data[7] & 2) != 0;
+    
+    // Which peers lost a note to which value is not saved, so clearing a
+    // value after a resume only gives back notes when auto notes are on
+    resetCandidates();
+    checkErrors();
+    journal_.clear();
+    lastHint_ = Hint();
+    
+    selectedCell_ = {-1, -1};
+    paused_ = false;
+    accumulatedPauseTime_ = 0;
+    totalElapsedSeconds_ = static_cast<int>(get32(&data[8]));
+    startTime_ = std::chrono::steady_clock::now() - std::chrono::seconds(totalElapsedSeconds_);
+    return true;
+}
+
+void Game::autosave() {
+    if (autoSaver_) {
+        autoSaver_->submit(saveSnapshot());
+    }
+}
+
+void Game::beginMove(int row, int col) {
+    lastHint_ = Hint();
+    moveCell_ = row * Board::SIZE + col;
+    moveValues_[0] = static_cast<uint8_t>(board_.getValue(row, col));
+    moveNotes_[0] = board_.getCell(row, col).getNotes();
+    for (int i = 0; i < PEER_COUNT; ++i) {
+        int peer = PEERS[moveCell_][i];
+        moveValues_[i + 1] = static_cast<uint8_t>(board_.getValue(ROW_OF[peer], COL_OF[peer]));
+        moveNotes_[i + 1] = board_.getCell(ROW_OF[peer], COL_OF[peer]).getNotes();
+    }
+}
+
+void Game::endMove() {
+    MoveJournal::Move move;
+    size_t count = 0;
+    for (int i = 0; i <= PEER_COUNT; ++i) {
+        int cell = i == 0 ? moveCell_ : PEERS[moveCell_][i - 1];
+        const Cell& now = board_.getCell(ROW_OF[cell], COL_OF[cell]);
+        if (now.getValue() == moveValues_[i] && now.getNotes() == moveNotes_[i]) continue;
+        
+        CellDelta& delta = move[count++];
+        delta.cell = static_cast<uint8_t>(cell);
+        delta.valueBefore = moveValues_[i];
+        delta.valueAfter = static_cast<uint8_t>(now.getValue());
+        delta.notesBefore = moveNotes_[i];
+        delta.notesAfter = now.getNotes();
+    }
+    journal_.record(move.data(), count);
+    moveCell_ = -1;
+}
+
+void Game::applyMove(const MoveJournal::Move& move, size_t count, bool undoing) {
+    for (size_t i = 0; i < count; ++i) {
+        const CellDelta& delta = move[i];
+        int from = undoing ? delta.valueAfter : delta.valueBefore;
+        int to = undoing ? delta.valueBefore : delta.valueAfter;
+        if (from != to) {
+            if (from != 0) {
+                countDigit(delta.cell, from, -1);
+            }
+            board_.setValue(ROW_OF[delta.cell], COL_OF[delta.cell], to);
+            if (to != 0) {
+                countDigit(delta.cell, to, 1);
+            }
+        }
+        board_.getCell(ROW_OF[delta.cell], COL_OF[delta.cell])
+            .setNotes(undoing ? delta.notesBefore : delta.notesAfter);
+    }
+    
+    // A digit this step puts back owns the peer notes the step takes away,
+    // as if placeDigit had just run
+    for (size_t i = 0; i < count; ++i) {
+        const CellDelta& delta = move[i];
+        int from = undoing ? delta.valueAfter : delta.valueBefore;
+        int to = undoing ? delta.valueBefore : delta.valueAfter;
+        if (from == to) continue;
+        
+        uint32_t eliminated = 0;
+        uint16_t bit = to != 0 ? static_cast<uint16_t>(1 << (to - 1)) : 0;
+        for (size_t j = 0; j < count && bit != 0; ++j) {
+            uint16_t notesFrom = undoing ? move[j].notesAfter : move[j].notesBefore;
+            uint16_t notesTo = undoing ? move[j].notesBefore : move[j].notesAfter;
+            if (!(notesFrom & bit) || (notesTo & bit)) continue;
+            for (int k = 0; k < PEER_COUNT; ++k) {
+                if (PEERS[delta.cell][k] == move[j].cell) {
+                    eliminated |= 1u << k;
+                }
+            }
+        }
+        eliminatedPeers_[delta.cell] = eliminated;
+    }
+    
+    for (size_t i = 0; i < count; ++i) {
+        refreshErrors(move[i].cell);
+    }
+}
+
+void Game::resetCandidates() {
+    for (auto& counts : unitCounts_) {
+        counts.fill(0);
+    }
+    eliminatedPeers_.fill(0);
+    unitDigits_.fill(0);
+    filledCells_ = 0;
+    conflicts_ = 0;
+    
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        int value = board_.getValue(ROW_OF[cell], COL_OF[cell]);
+        if (value != 0) {
+            countDigit(cell, value, 1);
+        }
+    }
+    
+    if (autoNotes_) {
+        fillAutoNotes();
+    }
+}
+
+void Game::fillAutoNotes() {
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        board_.getCell(ROW_OF[cell], COL_OF[cell]).setNotes(getCandidates(ROW_OF[cell], COL_OF[cell]));
+    }
+}
+
+void Game::countDigit(int cell, int value, int change) {
+    uint16_t bit = static_cast<uint16_t>(1 << (value - 1));
+    for (int unit : CELL_UNITS[cell]) {
+        uint8_t& count = unitCounts_[unit][value];
+        if (change > 0) {
+            if (++count == 1) {
+                unitDigits_[unit] |= bit;
+            } else if (count == 2) {
+                conflicts_++;
+            }
+        } else {
+            if (--count == 0) {
+                unitDigits_[unit] &= static_cast<uint16_t>(~bit);
+            } else if (count == 1) {
+                conflicts_--;
+            }
+        }
+    }
+    filledCells_ += change;
+}
+
+bool Game::hasConflict(int cell) const {
+    int value = board_.getValue(ROW_OF[cell], COL_OF[cell]);
+    if (value == 0) {
+        return false;
+    }
+    const auto& units = CELL_UNITS[cell];
+    return unitCounts_[units[0]][value] > 1 || unitCounts_[units[1]][value] > 1 ||
+           unitCounts_[units[2]][value] > 1;
+}
+
+void Game::refreshErrors(int cell) {
+    board_.getCell(ROW_OF[cell], COL_OF[cell]).setError(hasConflict(cell));
+    for (int peer : PEERS[cell]) {
+        board_.getCell(ROW_OF[peer], COL_OF[peer]).setError(hasConflict(peer));
+    }
+}
+
+uint16_t Game::getCandidates(int row, int col) const {
+    const auto& units = CELL_UNITS[row * Board::SIZE + col];
+    return static_cast<uint16_t>(~(unitDigits_[units[0]] | unitDigits_[units[1]] | unitDigits_[units[2]]) &
+                                 0x1FF);
+}
+
+void Game::placeDigit(int row, int col, int value) {
+    if (value < 1 || value > Board::SIZE) {
+        return;
+    }
+    
+    int cell = row * Board::SIZE + col;
+    board_.setValue(row, col, value);
+    countDigit(cell, value, 1);
+    
+    uint32_t eliminated = 0;
+    for (int i = 0; i < PEER_COUNT; ++i) {
+        int peer = PEERS[cell][i];
+        Cell& peerCell = board_.getCell(ROW_OF[peer], COL_OF[peer]);
+        if (peerCell.hasNote(value)) {
+            peerCell.removeNote(value);
+            eliminated |= 1u << i;
+        }
+    }
+    eliminatedPeers_[cell] = eliminated;
+}
+
+void Game::removeDigit(int row, int col) {
+    int value = board_.getValue(row, col);
+    if (value == 0) {
+        return;
+    }
+    
+    int cell = row * Board::SIZE + col;
+    board_.setValue(row, col, 0);
+    countDigit(cell, value, -1);
+    
+    // Give the digit back only where this cell took it and no other peer
+    // still rules it out; auto notes restore it wherever it is a candidate
+    uint32_t eliminated = eliminatedPeers_[cell];
+    eliminatedPeers_[cell] = 0;
+    uint16_t bit = static_cast<uint16_t>(1 << (value - 1));
+    for (int i = 0; i < PEER_COUNT; ++i) {
+        if (!autoNotes_ && !(eliminated & (1u << i))) continue;
+        
+        int peer = PEERS[cell][i];
+        int peerRow = ROW_OF[peer];
+        int peerCol = COL_OF[peer];
+        if (board_.getCell(peerRow, peerCol).isEmpty() && (getCandidates(peerRow, peerCol) & bit)) {
+            board_.getCell(peerRow, peerCol).addNote(value);
+        }
+    }
+    
+    if (autoNotes_) {
+        board_.getCell(row, col).setNotes(getCandidates(row, col));
+    }
+}
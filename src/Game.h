@@ -1,21 +1,47 @@
 //game.h
 #pragma once
 
+#include "AutoSaver.h"
 #include "Board.h"
+#include "HintEngine.h"
+#include "IncrementalSolver.h"
+#include "MoveJournal.h"
 #include "SudokuGenerator.h"
-#include "SudokuSolver.h"
+#include <array>
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 class Game {
 public:
+    // Versioned binary snapshot: givens, values, solution, notes, hints,
+    // elapsed time, difficulty and modes
+    static constexpr uint8_t SNAPSHOT_VERSION = 1;
+    static constexpr size_t SNAPSHOT_SIZE = 201;
+    // New Expert games run MinimalPuzzleSearch for this long
+    static constexpr std::chrono::milliseconds EXPERT_SEARCH_TIME{1000};
+    
     Game();
+    // Resumes the game saved at savePath if there is an unfinished one,
+    // otherwise starts a built-in medium puzzle without running the
+    // generator; every move is then autosaved there
+    explicit Game(const std::string& savePath);
     Difficulty getCurrentDifficulty() const;
     void newGame(Difficulty difficulty);
     void setValue(int row, int col, int value);
     void setNote(int row, int col, int value);
     void clearCell(int row, int col);
     
+    // Steps through the moves above, hints included (the hint is not given
+    // back). The history starts over with each game, on resume, when the
+    // solve animation lands and when auto notes refill the board.
+    void undo();
+    void redo();
+    bool canUndo() const;
+    bool canRedo() const;
+    
     bool isComplete() const;
     bool isPaused() const;
     void pause();
@@ -26,12 +52,33 @@ public:
     std::string getTimerString() const;
     int getElapsedSeconds() const;
     
+    // Places the digit of the next logical step and shows how it was found.
+    // A repeated digit is pointed out for free. When the step is beyond the
+    // hint engine, or a wrong digit sends it astray, the selected cell gets
+    // its digit from the solution as before.
     void useHint();
     int getHintsRemaining() const;
+    // The next logical step on the board as it stands; changes nothing
+    Hint getHint() const;
+    // What the last hint was based on; NONE after any other move
+    const Hint& getLastHint() const;
     
     void toggleNotesMode();
     bool isNotesMode() const;
     
+    // Fills every empty cell's notes with its candidates, then keeps them
+    // current as values are placed and cleared
+    void toggleAutoNotes();
+    bool isAutoNotes() const;
+    
+    // "Watch it solve": animates a solve from the givens without touching
+    // the player's board, which is replaced by the solution once it lands
+    void toggleAutoSolve();
+    bool isAutoSolving() const;
+    // Advances the animation by one frame's budget; call once per frame
+    void updateAutoSolve();
+    const IncrementalSolver& getAutoSolver() const;
+    
     void selectCell(int row, int col);
     std::pair<int, int> getSelectedCell() const;
     
@@ -40,6 +87,10 @@ public:
     
     void checkErrors();
     
+    std::vector<uint8_t> saveSnapshot() const;
+    // False, leaving the game untouched, if the data is not a valid snapshot
+    bool loadSnapshot(const std::vector<uint8_t>& data);
+    
 private:
     Board board_;
     Board solution_;
@@ -55,6 +106,60 @@ private:
     int accumulatedPauseTime_;
     int totalElapsedSeconds_;
     
-    void generateSolution();
+    bool autoNotes_;
+    // Occurrences of each digit in each row, column and box, so candidates
+    // are known without scanning the board
+    std::array<std::array<uint8_t, Board::SIZE + 1>, 3 * Board::SIZE> unitCounts_;
+    // Per filled cell, the peers (bit i for peer i) that lost a note to it
+    std::array<uint32_t, Board::SIZE * Board::SIZE> eliminatedPeers_;
+    // Kept with the unit counts so completion is known without a scan:
+    // filled cells, and unit-digit pairs held by more than one cell
+    int filledCells_;
+    int conflicts_;
+    // Bit value-1 for each digit present in each unit, the candidates' source
+    std::array<uint16_t, 3 * Board::SIZE> unitDigits_;
+    Hint lastHint_;
+    
+    MoveJournal journal_;
+    // The move being made: its cell, then the cell's peers, as they were
+    // before it. A move never changes anything outside them.
+    int moveCell_;
+    std::array<uint8_t, SudokuTables::PEER_COUNT + 1> moveValues_;
+    std::array<uint16_t, SudokuTables::PEER_COUNT + 1> moveNotes_;
+    
+    IncrementalSolver autoSolver_;
+    bool autoSolving_;
+    
+    // Keeps each frame well inside 16ms at 60 FPS
+    static constexpr std::chrono::microseconds AUTO_SOLVE_FRAME_BUDGET{4000};
+    // The per-frame node budget grows by one for every this many nodes
+    static constexpr uint64_t AUTO_SOLVE_SPEEDUP = 64;
+    
+    std::unique_ptr<AutoSaver> autoSaver_;
+    
+    // Starts one of the embedded puzzles, so construction never waits on
+    // the generator
+    void startupGame();
+    // Resets the play state for a fresh board_ and solution_
+    void beginGame(Difficulty difficulty);
+    // Hands a snapshot to the background writer; never touches the disk
+    void autosave();
+    
+    void beginMove(int row, int col);
+    // Journals whatever changed since beginMove
+    void endMove();
+    void applyMove(const MoveJournal::Move& move, size_t count, bool undoing);
+    
+    void resetCandidates();
+    // Adds (change 1) or removes (change -1) a digit in the unit counts
+    void countDigit(int cell, int value, int change);
+    bool hasConflict(int cell) const;
+    // Error flags of the cell and its peers, the only ones a change to it can affect
+    void refreshErrors(int cell);
+    void fillAutoNotes();
+    uint16_t getCandidates(int row, int col) const;
+    // Update the unit counts and peer notes along with the board
+    void placeDigit(int row, int col, int value);
+    void removeDigit(int row, int col);
 };
 
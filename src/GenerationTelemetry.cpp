@@ -0,0 +1,211 @@
+//telemetry.cpp
+#include "GenerationTelemetry.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+uint64_t toMicros(std::chrono::microseconds duration) {
+    return static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+}
+
+std::string difficultyLabel(int d) {
+    return std::string("difficulty=\"") +
+           SudokuGenerator::getDifficultyName(static_cast<Difficulty>(d)) + "\"";
+}
+
+} // namespace
+
+GenerationTelemetry::GenerationTelemetry() {
+}
+
+void GenerationTelemetry::record(Difficulty difficulty, const GenerationResult& result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DifficultyStats& stats = stats_[static_cast<int>(difficulty)];
+    
+    stats.total.record(toMicros(result.elapsed));
+    stats.fullBoard.record(toMicros(result.stats.fullBoardTime));
+    stats.uniqueness.record(toMicros(result.stats.uniquenessTime));
+    stats.uniquenessChecks += static_cast<uint64_t>(result.stats.uniquenessChecks);
+    stats.acceptedRemovals += static_cast<uint64_t>(result.stats.acceptedRemovals);
+    stats.rejectedRemovals += static_cast<uint64_t>(result.stats.rejectedRemovals);
+    if (!result.complete) {
+        stats.incomplete++;
+    }
+    if (result.clueCount > result.targetClues) {
+        stats.missedTarget++;
+        stats.extraClues += static_cast<uint64_t>(result.clueCount - result.targetClues);
+    }
+}
+
+bool GenerationTelemetry::exportJson(const std::string& path) const {
+    std::ostringstream out;
+    writeJson(out);
+    return writeFile(path, out.str());
+}
+
+bool GenerationTelemetry::exportPrometheus(const std::string& path) const {
+    std::ostringstream out;
+    writePrometheus(out);
+    return writeFile(path, out.str());
+}
+
+void GenerationTelemetry::writeJson(std::ostream& out) const {
+    std::array<DifficultyStats, DIFFICULTY_COUNT> stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats = stats_;
+    }
+    
+    out << "{\n";
+    for (int d = 0; d < DIFFICULTY_COUNT; ++d) {
+        const DifficultyStats& s = stats[d];
+        out << "  \"" << SudokuGenerator::getDifficultyName(static_cast<Difficulty>(d)) << "\": {\n"
+            << "    \"calls\": " << s.total.getCount() << ",\n"
+            << "    \"incomplete\": " << s.incomplete << ",\n"
+            << "    \"uniqueness_checks\": " << s.uniquenessChecks << ",\n"
+            << "    \"accepted_removals\": " << s.acceptedRemovals << ",\n"
+            << "    \"rejected_removals\": " << s.rejectedRemovals << ",\n"
+            << "    \"missed_target\": " << s.missedTarget << ",\n"
+            << "    \"extra_clues\": " << s.extraClues << ",\n"
+            << "    \"total_us\": ";
+        writeJsonHistogram(out, s.total);
+        out << ",\n    \"full_board_us\": ";
+        writeJsonHistogram(out, s.fullBoard);
+        out << ",\n    \"uniqueness_us\": ";
+        writeJsonHistogram(out, s.uniqueness);
+        out << "\n  }" << (d + 1 < DIFFICULTY_COUNT ? "," : "") << "\n";
+    }
+    out << "}\n";
+}
+
+void GenerationTelemetry::writePrometheus(std::ostream& out) const {
+    std::array<DifficultyStats, DIFFICULTY_COUNT> stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats = stats_;
+    }
+    
+    writePrometheusHistogram(out, "sudoku_generation_duration_seconds",
+                             "Wall time of SudokuGenerator::generate", stats,
+                             &DifficultyStats::total);
+    writePrometheusHistogram(out, "sudoku_generation_full_board_seconds",
+                             "Time spent building the full grid", stats,
+                             &DifficultyStats::fullBoard);
+    writePrometheusHistogram(out, "sudoku_generation_uniqueness_seconds",
+                             "Time spent waiting on uniqueness checks", stats,
+                             &DifficultyStats::uniqueness);
+    
+    struct Counter {
+        const char* name;
+        const char* help;
+        uint64_t DifficultyStats::*member;
+    };
+    const Counter counters[] = {
+        {"sudoku_generation_incomplete_total", "Calls stopped by a deadline or cancellation",
+         &DifficultyStats::incomplete},
+        {"sudoku_generation_uniqueness_checks_total", "Uniqueness checks run",
+         &DifficultyStats::uniquenessChecks},
+        {"sudoku_generation_accepted_removals_total", "Clue removals that kept the solution unique",
+         &DifficultyStats::acceptedRemovals},
+        {"sudoku_generation_rejected_removals_total", "Clue removals that broke uniqueness",
+         &DifficultyStats::rejectedRemovals},
+        {"sudoku_generation_missed_target_total", "Calls that ended above the clue target",
+         &DifficultyStats::missedTarget},
+        {"sudoku_generation_extra_clues_total", "Clues left above the target",
+         &DifficultyStats::extraClues},
+    };
+    for (const Counter& counter : counters) {
+        out << "# HELP " << counter.name << " " << counter.help << "\n"
+            << "# TYPE " << counter.name << " counter\n";
+        for (int d = 0; d < DIFFICULTY_COUNT; ++d) {
+            out << counter.name << "{" << difficultyLabel(d) << "} "
+                << stats[d].*counter.member << "\n";
+        }
+    }
+}
+
+void GenerationTelemetry::print(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int d = 0; d < DIFFICULTY_COUNT; ++d) {
+        const DifficultyStats& s = stats_[d];
+        if (s.total.getCount() == 0) continue;
+        
+        out << SudokuGenerator::getDifficultyName(static_cast<Difficulty>(d)) << " ("
+            << s.total.getCount() << " puzzles, " << s.uniquenessChecks << " checks, "
+            << s.acceptedRemovals << " accepted / " << s.rejectedRemovals << " rejected removals, "
+            << s.missedTarget << " above target):" << std::endl;
+        s.total.print(out);
+    }
+}
+
+void GenerationTelemetry::writeJsonHistogram(std::ostream& out, const LatencyHistogram& histogram) {
+    out << "{\"count\": " << histogram.getCount()
+        << ", \"sum\": " << histogram.getSum()
+        << ", \"max\": " << histogram.getMax()
+        << ", \"p50\": " << histogram.getPercentile(0.5)
+        << ", \"p90\": " << histogram.getPercentile(0.9)
+        << ", \"p99\": " << histogram.getPercentile(0.99)
+        << ", \"p999\": " << histogram.getPercentile(0.999)
+        << ", \"buckets\": [";
+    // Sparse [upper bound, count] pairs; empty buckets are omitted
+    bool first = true;
+    for (int b = 0; b < LatencyHistogram::BUCKETS; ++b) {
+        uint64_t count = histogram.getBucketCount(b);
+        if (count == 0) continue;
+        out << (first ? "" : ", ") << "[" << LatencyHistogram::getBucketUpperBound(b) << ", "
+            << count << "]";
+        first = false;
+    }
+    out << "]}";
+}
+
+void GenerationTelemetry::writePrometheusHistogram(
+        std::ostream& out, const std::string& name, const std::string& help,
+        const std::array<DifficultyStats, DIFFICULTY_COUNT>& stats,
+        LatencyHistogram DifficultyStats::*member) {
+    out << "# HELP " << name << " " << help << "\n"
+        << "# TYPE " << name << " histogram\n";
+    for (int d = 0; d < DIFFICULTY_COUNT; ++d) {
+        const LatencyHistogram& histogram = stats[d].*member;
+        std::string label = difficultyLabel(d);
+        
+        // The same ladder for every series, so they can be summed and compared.
+        // No HDR bucket straddles a power of two, and recorded values are
+        // truncated microseconds, so the buckets below 2^k hold exactly the
+        // durations shorter than 2^k us.
+        uint64_t cumulative = 0;
+        int b = 0;
+        for (int k = 0; k <= PROMETHEUS_MAX_BUCKET_BITS; ++k) {
+            uint64_t boundary = uint64_t(1) << k;
+            for (; b < LatencyHistogram::BUCKETS &&
+                   LatencyHistogram::getBucketUpperBound(b) < boundary; ++b) {
+                cumulative += histogram.getBucketCount(b);
+            }
+            // Fixed six decimals print whole microseconds exactly
+            out << name << "_bucket{" << label << ",le=\""
+                << std::to_string(static_cast<double>(boundary) / 1e6) << "\"} " << cumulative << "\n";
+        }
+        out << name << "_bucket{" << label << ",le=\"+Inf\"} " << histogram.getCount() << "\n"
+            << name << "_sum{" << label << "} "
+            << static_cast<double>(histogram.getSum()) / 1e6 << "\n"
+            << name << "_count{" << label << "} " << histogram.getCount() << "\n";
+    }
+}
+
+bool GenerationTelemetry::writeFile(const std::string& path, const std::string& contents) {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file || !(file << contents) || !file.flush()) {
+            return false;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,57 @@
+//telemetry.h
+#pragma once
+
+#include "LatencyHistogram.h"
+#include "SudokuGenerator.h"
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+// Aggregates GenerationStats per difficulty. Pass it through
+// GeneratorOptions::telemetry; recording is thread-safe, so one instance
+// can be shared by every generating thread.
+class GenerationTelemetry {
+public:
+    GenerationTelemetry();
+    
+    void record(Difficulty difficulty, const GenerationResult& result);
+    
+    // The file is written beside the target and renamed over it, so a
+    // scraper never reads a partial export. False if it could not be written.
+    bool exportJson(const std::string& path) const;
+    bool exportPrometheus(const std::string& path) const;
+    
+    void writeJson(std::ostream& out) const;
+    void writePrometheus(std::ostream& out) const;
+    void print(std::ostream& out) const;
+    
+private:
+    static constexpr int DIFFICULTY_COUNT = 4;
+    // Prometheus buckets sit at every power of two of microseconds up to
+    // 2^PROMETHEUS_MAX_BUCKET_BITS (about 72 minutes), whether or not they are empty
+    static constexpr int PROMETHEUS_MAX_BUCKET_BITS = 32;
+    
+    struct DifficultyStats {
+        LatencyHistogram total;
+        LatencyHistogram fullBoard;
+        LatencyHistogram uniqueness;
+        uint64_t incomplete = 0;
+        uint64_t uniquenessChecks = 0;
+        uint64_t acceptedRemovals = 0;
+        uint64_t rejectedRemovals = 0;
+        uint64_t missedTarget = 0;  // calls that ended above the clue target
+        uint64_t extraClues = 0;    // sum of clues left above the target
+    };
+    
+    mutable std::mutex mutex_;
+    std::array<DifficultyStats, DIFFICULTY_COUNT> stats_;
+    
+    static void writeJsonHistogram(std::ostream& out, const LatencyHistogram& histogram);
+    static void writePrometheusHistogram(std::ostream& out, const std::string& name,
+                                         const std::string& help,
+                                         const std::array<DifficultyStats, DIFFICULTY_COUNT>& stats,
+                                         LatencyHistogram DifficultyStats::*member);
+    static bool writeFile(const std::string& path, const std::string& contents);
+};
@@ -0,0 +1,60 @@
+//gridsampler.cpp
+#include "GridSampler.h"
+#include "SudokuTransformer.h"
+#include <algorithm>
+
+namespace {
+
+constexpr int N = Board::SIZE;
+constexpr int B = Board::BOX_SIZE;
+
+} // namespace
+
+GridSampler::Grid GridSampler::sample(std::mt19937& rng) {
+    for (;;) {
+        Grid grid{};
+        std::array<uint8_t, N> row;
+        for (int i = 0; i < N; ++i) {
+            row[i] = static_cast<uint8_t>(i + 1);
+        }
+        std::shuffle(row.begin(), row.end(), rng);
+        std::copy(row.begin(), row.end(), grid.begin());
+        
+        // The rest of the first column: its first box may not reuse the
+        // digits of the first row's box, the lower six cells take what is left
+        std::array<uint8_t, N - 1> column;
+        std::copy(row.begin() + 1, row.end(), column.begin());
+        std::shuffle(column.begin() + B - 1, column.end(), rng);
+        std::swap(column[0], column[B - 1]);
+        std::swap(column[1], column[B]);
+        std::shuffle(column.begin() + B - 1, column.end(), rng);
+        for (int r = 1; r < N; ++r) {
+            grid[r * N] = column[r - 1];
+        }
+        
+        if (BitboardSolver::randomFill(grid, rng, FILL_NODE_BUDGET)) {
+            return transform(grid, rng);
+        }
+    }
+}
+
+GridSampler::Grid GridSampler::transform(const Grid& grid, std::mt19937& rng) {
+    return SudokuTransformer::apply(grid, SudokuTransform::random(rng));
+}
+
+GridPool::GridPool(size_t size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    grids_.reserve(std::max<size_t>(size, 1));
+    for (size_t i = 0; i < std::max<size_t>(size, 1); ++i) {
+        grids_.push_back(GridSampler::sample(rng));
+    }
+}
+
+GridSampler::Grid GridPool::draw(std::mt19937& rng) const {
+    size_t index = std::uniform_int_distribution<size_t>(0, grids_.size() - 1)(rng);
+    return GridSampler::transform(grids_[index], rng);
+}
+
+size_t GridPool::size() const {
+    return grids_.size();
+}
@@ -0,0 +1,49 @@
+//gridsampler.h
+#pragma once
+
+#include "BitboardSolver.h"
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Complete solution grids in microseconds, for the generator's first step.
+//
+// sample() draws the first row and column as random permutations, lets
+// BitboardSolver::randomFill complete the other 64 cells under a node
+// budget (restarting on the rare dead end), then applies a random
+// validity-preserving transform.
+//
+// Uniformity: the transform makes every grid equally likely within its
+// equivalence class (digit relabelling, row and column moves inside bands
+// and stacks, band and stack moves, transposition). The classes
+// themselves are weighted by the search and not exactly by their size,
+// so this is not a uniform sample of all 6.67e21 grids.
+class GridSampler {
+public:
+    using Grid = BitboardSolver::Grid;
+    
+    static constexpr uint64_t FILL_NODE_BUDGET = 2000;
+    
+    static Grid sample(std::mt19937& rng);
+    // Random member of the grid's equivalence class
+    static Grid transform(const Grid& grid, std::mt19937& rng);
+};
+
+// Base grids built once up front, for bulk generation. draw() is a random
+// transform of a random base grid: O(81) with no search at all. It is
+// uniform within the base grids' equivalence classes and never leaves
+// them, so the pool should be larger than the batch is long. Thread-safe
+// once built.
+class GridPool {
+public:
+    static constexpr size_t DEFAULT_SIZE = 1024;
+    
+    explicit GridPool(size_t size = DEFAULT_SIZE, uint32_t seed = 0);
+    
+    GridSampler::Grid draw(std::mt19937& rng) const;
+    size_t size() const;
+    
+private:
+    std::vector<GridSampler::Grid> grids_;
+};
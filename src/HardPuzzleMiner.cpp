@@ -0,0 +1,197 @@
+//miner.cpp
+#include "HardPuzzleMiner.h"
+#include "SudokuCanonicalizer.h"
+#include "SudokuSolver.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <mutex>
+
+struct HardPuzzleMiner::Shared {
+    struct Entry {
+        uint64_t hash;  // canonical, so equivalent puzzles share it
+        MinedPuzzle mined;
+    };
+    
+    const MinerOptions& options;
+    const SearchLimits& limits;
+    
+    std::mutex mutex;
+    std::vector<Entry> top;
+    std::atomic<uint64_t> threshold{0};  // nodes a puzzle needs to enter a full list
+    std::atomic<uint64_t> evaluations{0};
+    std::atomic<uint64_t> restarts{0};
+    
+    Shared(const MinerOptions& minerOptions, const SearchLimits& searchLimits)
+        : options(minerOptions)
+        , limits(searchLimits) {
+    }
+    
+    void offer(const Grid& puzzle, uint64_t nodes) {
+        if (options.topK == 0 || nodes <= threshold.load(std::memory_order_relaxed)) {
+            return;
+        }
+        // Canonicalising is the slow part; only done for puzzles that qualify
+        uint64_t hash = SudokuCanonicalizer::canonicalHash(BitboardSolver::toBoard(puzzle));
+        int clues = static_cast<int>(std::count_if(puzzle.begin(), puzzle.end(),
+                                                   [](uint8_t value) { return value != 0; }));
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Entry& entry : top) {
+            if (entry.hash == hash) {
+                // Engines break ties by cell order, so an equivalent puzzle can cost more
+                if (nodes > entry.mined.nodes) {
+                    entry.mined = MinedPuzzle{puzzle, nodes, clues};
+                }
+                return;
+            }
+        }
+        top.push_back(Entry{hash, MinedPuzzle{puzzle, nodes, clues}});
+        
+        auto easiest = [this]() {
+            return std::min_element(top.begin(), top.end(), [](const Entry& a, const Entry& b) {
+                return a.mined.nodes < b.mined.nodes;
+            });
+        };
+        if (top.size() > options.topK) {
+            top.erase(easiest());
+        }
+        if (top.size() == options.topK) {
+            threshold = easiest()->mined.nodes;
+        }
+    }
+};
+
+MinerResult HardPuzzleMiner::mine(const MinerOptions& options, const SearchLimits& limits) {
+    auto start = std::chrono::steady_clock::now();
+    Shared shared(options, limits);
+    
+    uint32_t seed = options.seed ? *options.seed : std::random_device()();
+    int threads = ThreadPool::resolveThreadCount(options.threads);
+    {
+        ThreadPool pool(threads);
+        std::vector<std::future<void>> workers;
+        for (int i = 0; i < threads; ++i) {
+            workers.push_back(pool.submit([&shared, seed, i]() {
+                runWorker(shared, seed + static_cast<uint32_t>(i) * 0x9E3779B9u);
+            }));
+        }
+        for (auto& worker : workers) {
+            worker.get();
+        }
+    }
+    
+    MinerResult result;
+    for (const auto& entry : shared.top) {
+        result.puzzles.push_back(entry.mined);
+    }
+    std::sort(result.puzzles.begin(), result.puzzles.end(),
+              [](const MinedPuzzle& a, const MinedPuzzle& b) { return a.nodes > b.nodes; });
+    result.evaluations = shared.evaluations;
+    result.restarts = shared.restarts;
+    result.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    return result;
+}
+
+int64_t HardPuzzleMiner::measure(MinerEngine engine, const Grid& puzzle,
+                                 const SearchLimits& limits) {
+    uint64_t nodes = 0;
+    if (engine == MinerEngine::BACKTRACK) {
+        SudokuSolver::Result result = SudokuSolver::countSolutions(
+            BitboardSolver::toBoard(puzzle), 2, nullptr, &limits, &nodes);
+        return result == SudokuSolver::Result::SOLVED ? static_cast<int64_t>(nodes) : -1;
+    }
+    int solutions = BitboardSolver::countSolutions(puzzle, 2, nullptr, &limits, &nodes);
+    return solutions == 1 ? static_cast<int64_t>(nodes) : -1;
+}
+
+const char* HardPuzzleMiner::getEngineName(MinerEngine engine) {
+    switch (engine) {
+        case MinerEngine::BITBOARD:
+            return "bitboard";
+        case MinerEngine::BACKTRACK:
+            return "backtrack";
+        default:
+            return "unknown";
+    }
+}
+
+void HardPuzzleMiner::runWorker(Shared& shared, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    const MinerOptions& options = shared.options;
+    const SearchLimits& limits = shared.limits;
+    
+    while (!limits.shouldStop()) {
+        shared.restarts++;
+        
+        // Start from a random grid with clues dropped greedily while the
+        // solution stays unique
+        Grid solution{};
+        BitboardSolver::randomFill(solution, rng);
+        Grid puzzle = solution;
+        std::vector<int> order(puzzle.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = static_cast<int>(i);
+        }
+        std::shuffle(order.begin(), order.end(), rng);
+        for (int i : order) {
+            puzzle[i] = 0;
+            if (BitboardSolver::countSolutions(puzzle, 2) != 1) {
+                puzzle[i] = solution[i];
+            }
+        }
+        
+        int64_t nodes = measure(options.engine, puzzle, limits);
+        if (nodes < 0) {
+            return; // a minimal puzzle is unique, so only the limits get here
+        }
+        shared.evaluations++;
+        shared.offer(puzzle, static_cast<uint64_t>(nodes));
+        
+        double temperature = options.startTemperature;
+        for (int step = 0; step < options.stepsPerRestart && !limits.shouldStop(); ++step) {
+            temperature *= options.cooling;
+            
+            std::vector<int> given;
+            std::vector<int> empty;
+            for (int i = 0; i < static_cast<int>(puzzle.size()); ++i) {
+                (puzzle[i] ? given : empty).push_back(i);
+            }
+            
+            // Swap a clue for another cell most of the time, else drop or add one
+            Grid candidate = puzzle;
+            int move = std::uniform_int_distribution<int>(0, 9)(rng);
+            bool drop = move < 9;
+            bool add = move < 7 || move == 9;
+            if (drop) {
+                int out = given[std::uniform_int_distribution<size_t>(0, given.size() - 1)(rng)];
+                candidate[out] = 0;
+            }
+            if (add && !empty.empty()) {
+                int in = empty[std::uniform_int_distribution<size_t>(0, empty.size() - 1)(rng)];
+                candidate[in] = solution[in];
+            }
+            
+            int64_t candidateNodes = measure(options.engine, candidate, limits);
+            if (candidateNodes < 0) {
+                if (limits.shouldStop()) {
+                    return;
+                }
+                continue; // no longer unique
+            }
+            shared.evaluations++;
+            
+            double delta = std::log(static_cast<double>(candidateNodes) + 1.0) -
+                           std::log(static_cast<double>(nodes) + 1.0);
+            if (delta >= 0 || chance(rng) < std::exp(delta / temperature)) {
+                puzzle = candidate;
+                nodes = candidateNodes;
+                shared.offer(puzzle, static_cast<uint64_t>(nodes));
+            }
+        }
+    }
+}
@@ -0,0 +1,65 @@
+//miner.h
+#pragma once
+
+#include "BitboardSolver.h"
+#include "CancellationToken.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+// Engine whose search effort the miner maximises
+enum class MinerEngine {
+    BITBOARD = 0,   // BitboardSolver::countSolutions
+    BACKTRACK = 1   // SudokuSolver::countSolutions
+};
+
+struct MinerOptions {
+    MinerEngine engine = MinerEngine::BITBOARD;
+    size_t topK = 100;
+    int threads = 0;                  // 0 = all cores
+    std::optional<uint32_t> seed;     // worker streams are derived from it
+    int stepsPerRestart = 2000;       // annealing steps before a fresh grid
+    double startTemperature = 1.0;    // in natural-log units of node count
+    double cooling = 0.998;           // temperature factor per step
+};
+
+struct MinedPuzzle {
+    BitboardSolver::Grid puzzle;
+    uint64_t nodes;                   // nodes to prove the solution unique
+    int clueCount;
+};
+
+struct MinerResult {
+    std::vector<MinedPuzzle> puzzles; // hardest first, no two equivalent
+    uint64_t evaluations;
+    uint64_t restarts;
+    std::chrono::microseconds elapsed;
+};
+
+// Mines puzzles that make a solver work hardest, for a worst-case
+// benchmark corpus. Each worker anneals over the clue set of a random
+// grid: a move swaps a clue for another cell of the same solution, or
+// drops or adds one, and is kept only if the solution stays unique.
+// Uphill moves in log node count are always taken, downhill ones with
+// the usual exp(delta / T) chance. Workers share one top-K list, with
+// symmetry-equivalent puzzles counted once.
+class HardPuzzleMiner {
+public:
+    using Grid = BitboardSolver::Grid;
+    
+    // Runs until the limits stop it
+    static MinerResult mine(const MinerOptions& options, const SearchLimits& limits);
+    
+    // Nodes the engine visits counting up to two solutions; -1 if the
+    // puzzle is not unique or the limits stopped the count
+    static int64_t measure(MinerEngine engine, const Grid& puzzle, const SearchLimits& limits);
+    
+    static const char* getEngineName(MinerEngine engine);
+    
+private:
+    struct Shared;
+    
+    static void runWorker(Shared& shared, uint32_t seed);
+};
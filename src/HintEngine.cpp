@@ -0,0 +1,331 @@
+//hintengine.cpp
+#include "HintEngine.h"
+
+namespace {
+
+constexpr int N = SudokuTables::SIZE;
+constexpr int CELLS = SudokuTables::CELL_COUNT;
+constexpr int UNIT_COUNT = SudokuTables::UNIT_COUNT;
+constexpr uint16_t ALL_DIGITS = 0x1FF;
+
+using SudokuTables::ROW_OF;
+using SudokuTables::COL_OF;
+using SudokuTables::BOX_OF;
+using SudokuTables::UNITS;
+using SudokuTables::CELL_UNITS;
+
+using Grid = HintEngine::Grid;
+using Candidates = HintEngine::Candidates;
+
+constexpr std::array<uint8_t, 512> makePopcounts() {
+    std::array<uint8_t, 512> counts{};
+    for (int mask = 0; mask < 512; ++mask) {
+        for (int bit = mask; bit; bit &= bit - 1) {
+            counts[mask]++;
+        }
+    }
+    return counts;
+}
+
+constexpr std::array<uint8_t, 512> POPCOUNT = makePopcounts();
+
+// Boxes first: a hidden single in a box is the easiest thing to spot
+constexpr std::array<int, UNIT_COUNT> makeUnitOrder() {
+    std::array<int, UNIT_COUNT> order{};
+    for (int i = 0; i < UNIT_COUNT; ++i) {
+        order[i] = (i + 2 * N) % UNIT_COUNT;
+    }
+    return order;
+}
+
+constexpr std::array<int, UNIT_COUNT> UNIT_ORDER = makeUnitOrder();
+
+// Lowest digit in a mask
+int digitOf(uint16_t mask) {
+    int digit = 1;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++digit;
+    }
+    return digit;
+}
+
+// Index of the single set bit of a mask, -1 if it has several
+int onlyBit(int mask) {
+    if (mask == 0 || (mask & (mask - 1)) != 0) {
+        return -1;
+    }
+    return digitOf(static_cast<uint16_t>(mask)) - 1;
+}
+
+bool inUnit(int cell, int unit) {
+    const auto& units = CELL_UNITS[cell];
+    return units[0] == unit || units[1] == unit || units[2] == unit;
+}
+
+enum class SingleSearch {
+    FOUND,
+    NONE,
+    CONTRADICTION  // an empty cell or a missing digit has nowhere to go
+};
+
+SingleSearch findSingle(const Grid& values, const Candidates& candidates, Hint& hint) {
+    for (int unit : UNIT_ORDER) {
+        uint16_t once = 0;
+        uint16_t twice = 0;
+        uint16_t placed = 0;
+        for (int cell : UNITS[unit]) {
+            if (values[cell] != 0) {
+                placed |= static_cast<uint16_t>(1 << (values[cell] - 1));
+            } else {
+                twice |= once & candidates[cell];
+                once |= candidates[cell];
+            }
+        }
+        if ((once | placed) != ALL_DIGITS) {
+            return SingleSearch::CONTRADICTION;
+        }
+        
+        uint16_t singles = once & ~twice & ~placed & ALL_DIGITS;
+        if (singles != 0) {
+            int digit = digitOf(singles);
+            for (int cell : UNITS[unit]) {
+                if (values[cell] == 0 && (candidates[cell] & (1 << (digit - 1)))) {
+                    hint.technique = HintTechnique::HIDDEN_SINGLE;
+                    hint.cell = cell;
+                    hint.value = digit;
+                    hint.unit = unit;
+                    return SingleSearch::FOUND;
+                }
+            }
+        }
+    }
+    
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (values[cell] != 0) continue;
+        if (candidates[cell] == 0) {
+            return SingleSearch::CONTRADICTION;
+        }
+        if (POPCOUNT[candidates[cell]] == 1) {
+            hint.technique = HintTechnique::NAKED_SINGLE;
+            hint.cell = cell;
+            hint.value = digitOf(candidates[cell]);
+            hint.unit = -1;
+            return SingleSearch::FOUND;
+        }
+    }
+    return SingleSearch::NONE;
+}
+
+struct Elimination {
+    HintTechnique technique;
+    int unit;
+    int digit;
+};
+
+// Clears the digits from the empty cells of target outside excluded
+bool clear(const Grid& values, Candidates& candidates, int target, int excluded, uint16_t digits) {
+    bool changed = false;
+    for (int cell : UNITS[target]) {
+        if (values[cell] == 0 && !inUnit(cell, excluded) && (candidates[cell] & digits)) {
+            candidates[cell] &= static_cast<uint16_t>(~digits);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool pointing(const Grid& values, Candidates& candidates, Elimination& step) {
+    for (int box = 0; box < N; ++box) {
+        int boxUnit = 2 * N + box;
+        for (int digit = 1; digit <= N; ++digit) {
+            uint16_t bit = static_cast<uint16_t>(1 << (digit - 1));
+            int rows = 0;
+            int cols = 0;
+            for (int cell : UNITS[boxUnit]) {
+                if (values[cell] == 0 && (candidates[cell] & bit)) {
+                    rows |= 1 << ROW_OF[cell];
+                    cols |= 1 << COL_OF[cell];
+                }
+            }
+            
+            int row = onlyBit(rows);
+            int col = onlyBit(cols);
+            if ((row >= 0 && clear(values, candidates, row, boxUnit, bit)) ||
+                (col >= 0 && clear(values, candidates, N + col, boxUnit, bit))) {
+                step = {HintTechnique::POINTING, boxUnit, digit};
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool claiming(const Grid& values, Candidates& candidates, Elimination& step) {
+    for (int line = 0; line < 2 * N; ++line) {
+        for (int digit = 1; digit <= N; ++digit) {
+            uint16_t bit = static_cast<uint16_t>(1 << (digit - 1));
+            int boxes = 0;
+            for (int cell : UNITS[line]) {
+                if (values[cell] == 0 && (candidates[cell] & bit)) {
+                    boxes |= 1 << BOX_OF[cell];
+                }
+            }
+            
+            int box = onlyBit(boxes);
+            if (box >= 0 && clear(values, candidates, 2 * N + box, line, bit)) {
+                step = {HintTechnique::CLAIMING, line, digit};
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool nakedPair(const Grid& values, Candidates& candidates, Elimination& step) {
+    for (int unit : UNIT_ORDER) {
+        const auto& cells = UNITS[unit];
+        for (int i = 0; i < N; ++i) {
+            uint16_t pair = candidates[cells[i]];
+            if (values[cells[i]] != 0 || POPCOUNT[pair] != 2) continue;
+            for (int j = i + 1; j < N; ++j) {
+                if (values[cells[j]] != 0 || candidates[cells[j]] != pair) continue;
+                
+                uint16_t removed = 0;
+                for (int cell : cells) {
+                    if (cell == cells[i] || cell == cells[j] || values[cell] != 0) continue;
+                    removed |= candidates[cell] & pair;
+                    candidates[cell] &= static_cast<uint16_t>(~pair);
+                }
+                if (removed != 0) {
+                    step = {HintTechnique::NAKED_PAIR, unit, digitOf(removed)};
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+std::string cellName(int cell) {
+    return "r" + std::to_string(ROW_OF[cell] + 1) + "c" + std::to_string(COL_OF[cell] + 1);
+}
+
+std::string unitName(int unit) {
+    static const char* const kinds[] = {"row ", "column ", "box "};
+    return kinds[unit / N] + std::to_string(unit % N + 1);
+}
+
+} // namespace
+
+Hint HintEngine::findHint(const Grid& values) {
+    std::array<uint16_t, UNIT_COUNT> used{};
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (values[cell] == 0 || values[cell] > N) continue;
+        for (int unit : CELL_UNITS[cell]) {
+            used[unit] |= static_cast<uint16_t>(1 << (values[cell] - 1));
+        }
+    }
+    
+    Candidates candidates;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        const auto& units = CELL_UNITS[cell];
+        candidates[cell] = static_cast<uint16_t>(~(used[units[0]] | used[units[1]] | used[units[2]]));
+    }
+    return findHint(values, candidates);
+}
+
+Hint HintEngine::findHint(const Grid& values, Candidates candidates) {
+    Hint hint;
+    for (int unit = 0; unit < UNIT_COUNT; ++unit) {
+        uint16_t seen = 0;
+        for (int cell : UNITS[unit]) {
+            int value = values[cell];
+            if (value > N) {
+                return hint;
+            }
+            if (value == 0) continue;
+            uint16_t bit = static_cast<uint16_t>(1 << (value - 1));
+            if (seen & bit) {
+                hint.technique = HintTechnique::CONFLICT;
+                hint.cell = cell;
+                hint.value = value;
+                hint.unit = unit;
+                return hint;
+            }
+            seen |= bit;
+        }
+    }
+    
+    for (int cell = 0; cell < CELLS; ++cell) {
+        candidates[cell] = values[cell] == 0 ? candidates[cell] & ALL_DIGITS : 0;
+    }
+    
+    // Each elimination clears at least one candidate, so this ends
+    Elimination hardest = {HintTechnique::NONE, -1, 0};
+    for (int steps = 0;; ++steps) {
+        SingleSearch search = findSingle(values, candidates, hint);
+        if (search == SingleSearch::FOUND) {
+            if (steps > 0) {
+                hint.technique = hardest.technique;
+                hint.unit = hardest.unit;
+                hint.eliminated = hardest.digit;
+            }
+            hint.steps = steps;
+            return hint;
+        }
+        if (search == SingleSearch::CONTRADICTION) {
+            return Hint();
+        }
+        
+        Elimination step;
+        if (!pointing(values, candidates, step) && !claiming(values, candidates, step) &&
+            !nakedPair(values, candidates, step)) {
+            return Hint();
+        }
+        if (step.technique > hardest.technique) {
+            hardest = step;
+        }
+    }
+}
+
+const char* HintEngine::getTechniqueName(HintTechnique technique) {
+    switch (technique) {
+        case HintTechnique::NONE: return "none";
+        case HintTechnique::CONFLICT: return "conflict";
+        case HintTechnique::HIDDEN_SINGLE: return "hidden single";
+        case HintTechnique::NAKED_SINGLE: return "naked single";
+        case HintTechnique::POINTING: return "pointing";
+        case HintTechnique::CLAIMING: return "claiming";
+        case HintTechnique::NAKED_PAIR: return "naked pair";
+    }
+    return "unknown";
+}
+
+std::string HintEngine::describe(const Hint& hint) {
+    std::string digit = std::to_string(hint.value);
+    std::string eliminated = std::to_string(hint.eliminated);
+    std::string then = "; then " + cellName(hint.cell) + " is " + digit;
+    switch (hint.technique) {
+        case HintTechnique::NONE:
+            return "No hint: the next step needs a harder technique";
+        case HintTechnique::CONFLICT:
+            return "Conflict: the " + digit + " at " + cellName(hint.cell) + " repeats in " +
+                   unitName(hint.unit);
+        case HintTechnique::HIDDEN_SINGLE:
+            return "Hidden single: " + cellName(hint.cell) + " is the only place for " + digit +
+                   " in " + unitName(hint.unit);
+        case HintTechnique::NAKED_SINGLE:
+            return "Naked single: " + digit + " is the only candidate left for " + cellName(hint.cell);
+        case HintTechnique::POINTING:
+            return "Pointing: the " + eliminated + "s in " + unitName(hint.unit) +
+                   " share a line, ruling out " + eliminated + " elsewhere on it" + then;
+        case HintTechnique::CLAIMING:
+            return "Claiming: the " + eliminated + "s in " + unitName(hint.unit) +
+                   " share a box, ruling out " + eliminated + " elsewhere in it" + then;
+        case HintTechnique::NAKED_PAIR:
+            return "Naked pair in " + unitName(hint.unit) + " rules out " + eliminated +
+                   " elsewhere in it" + then;
+    }
+    return std::string();
+}
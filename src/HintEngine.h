@@ -0,0 +1,47 @@
+//hintengine.h
+#pragma once
+
+#include "SudokuTables.h"
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Techniques from easiest to hardest
+enum class HintTechnique {
+    NONE = 0,           // nothing below finds the next digit
+    CONFLICT = 1,       // a digit repeats in a unit; fix that first
+    HIDDEN_SINGLE = 2,  // the only place for a digit in a unit
+    NAKED_SINGLE = 3,   // the only digit left for a cell
+    POINTING = 4,       // a box's candidates for a digit share one line
+    CLAIMING = 5,       // a line's candidates for a digit share one box
+    NAKED_PAIR = 6      // two cells of a unit hold the same two candidates
+};
+
+struct Hint {
+    HintTechnique technique = HintTechnique::NONE;  // hardest step needed
+    int cell = -1;       // where the digit goes, or the repeated digit's cell
+    int value = 0;
+    int unit = -1;       // unit the hardest step works in (SudokuTables numbering)
+    int eliminated = 0;  // digit the hardest elimination ruled out, 0 for a single
+    int steps = 0;       // eliminations made before the digit could be placed
+};
+
+// The easiest logical next step on a board, found from bitmask candidate
+// state with no search. Singles are tried first; failing those, the
+// cheapest elimination is made and singles tried again, until a digit can
+// be placed. The hint names that digit and the hardest technique it took.
+// Every call costs a few microseconds and touches no shared state.
+class HintEngine {
+public:
+    using Grid = std::array<uint8_t, SudokuTables::CELL_COUNT>;
+    // Bit value-1 per candidate of each empty cell; ignored for filled ones
+    using Candidates = std::array<uint16_t, SudokuTables::CELL_COUNT>;
+    
+    static Hint findHint(const Grid& values);
+    // For callers that keep candidates up to date as digits come and go
+    static Hint findHint(const Grid& values, Candidates candidates);
+    
+    static const char* getTechniqueName(HintTechnique technique);
+    // "Hidden single: 4 is the only place for a 4 in box 5 at r5c6" style
+    static std::string describe(const Hint& hint);
+};
@@ -0,0 +1,177 @@
+//incremental.cpp
+#include "IncrementalSolver.h"
+#include "SudokuTables.h"
+
+namespace {
+
+constexpr uint16_t ALL_VALUES = 0x1FF;
+
+using SudokuTables::ROW_OF;
+using SudokuTables::COL_OF;
+using SudokuTables::BOX_OF;
+
+int lowestValue(uint16_t mask) {
+    int value = 1;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        value++;
+    }
+    return value;
+}
+
+int countBits(uint16_t mask) {
+    int count = 0;
+    for (; mask; mask &= mask - 1) {
+        count++;
+    }
+    return count;
+}
+
+} // namespace
+
+IncrementalSolver::IncrementalSolver() {
+    reset();
+}
+
+void IncrementalSolver::reset() {
+    board_ = Board();
+    state_ = State::IDLE;
+    depth_ = 0;
+    descend_ = true;
+    nodes_ = 0;
+    lastCell_ = -1;
+    rowUsed_.fill(0);
+    colUsed_.fill(0);
+    boxUsed_.fill(0);
+}
+
+void IncrementalSolver::start(const Board& puzzle) {
+    reset();
+    state_ = State::RUNNING;
+    
+    for (int i = 0; i < CELL_COUNT; ++i) {
+        const Cell& cell = puzzle.getCell(ROW_OF[i], COL_OF[i]);
+        if (!cell.isGiven() || cell.isEmpty()) continue;
+        
+        int value = cell.getValue();
+        uint16_t bit = static_cast<uint16_t>(1 << (value - 1));
+        if ((rowUsed_[ROW_OF[i]] | colUsed_[COL_OF[i]] | boxUsed_[BOX_OF[i]]) & bit) {
+            state_ = State::UNSOLVABLE; // givens already conflict
+        }
+        board_.setValue(ROW_OF[i], COL_OF[i], value);
+        board_.getCell(ROW_OF[i], COL_OF[i]).setGiven(true);
+        rowUsed_[ROW_OF[i]] |= bit;
+        colUsed_[COL_OF[i]] |= bit;
+        boxUsed_[BOX_OF[i]] |= bit;
+    }
+}
+
+IncrementalSolver::State IncrementalSolver::step(uint64_t maxNodes,
+                                                 std::chrono::microseconds maxTime) {
+    auto deadline = std::chrono::steady_clock::now() + maxTime;
+    
+    for (uint64_t n = 0; n < maxNodes && state_ == State::RUNNING; ++n) {
+        // Reading the clock costs more than a node; check it every 64
+        if (n % 64 == 63 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        advance();
+    }
+    return state_;
+}
+
+IncrementalSolver::State IncrementalSolver::getState() const {
+    return state_;
+}
+
+const Board& IncrementalSolver::getBoard() const {
+    return board_;
+}
+
+uint64_t IncrementalSolver::getNodes() const {
+    return nodes_;
+}
+
+std::pair<int, int> IncrementalSolver::getLastCell() const {
+    if (lastCell_ < 0) {
+        return {-1, -1};
+    }
+    return {ROW_OF[lastCell_], COL_OF[lastCell_]};
+}
+
+void IncrementalSolver::advance() {
+    // One call is one node: open a frame for the next cell if the last
+    // placement succeeded, then place the next untried value, backtracking
+    // through exhausted frames
+    if (descend_) {
+        descend_ = false;
+        int cell;
+        uint16_t candidates;
+        if (!pickCell(cell, candidates)) {
+            state_ = State::SOLVED;
+            return;
+        }
+        if (candidates != 0) {
+            stack_[depth_++] = {cell, candidates, 0};
+        }
+    }
+    
+    while (depth_ > 0) {
+        Frame& frame = stack_[depth_ - 1];
+        if (frame.placed != 0) {
+            unplace(frame.cell, frame.placed);
+            frame.placed = 0;
+        }
+        if (frame.candidates == 0) {
+            depth_--;
+            continue;
+        }
+        
+        int value = lowestValue(frame.candidates);
+        frame.candidates &= static_cast<uint16_t>(frame.candidates - 1);
+        place(frame.cell, value);
+        frame.placed = value;
+        nodes_++;
+        descend_ = true;
+        return;
+    }
+    
+    state_ = State::UNSOLVABLE;
+}
+
+bool IncrementalSolver::pickCell(int& cell, uint16_t& candidates) const {
+    int bestCount = Board::SIZE + 1;
+    for (int i = 0; i < CELL_COUNT; ++i) {
+        if (board_.getValue(ROW_OF[i], COL_OF[i]) != 0) continue;
+        
+        uint16_t free = ALL_VALUES & ~(rowUsed_[ROW_OF[i]] | colUsed_[COL_OF[i]] | boxUsed_[BOX_OF[i]]);
+        int count = countBits(free);
+        if (count < bestCount) {
+            bestCount = count;
+            cell = i;
+            candidates = free;
+            if (count <= 1) {
+                return true;
+            }
+        }
+    }
+    return bestCount <= Board::SIZE;
+}
+
+void IncrementalSolver::place(int cell, int value) {
+    uint16_t bit = static_cast<uint16_t>(1 << (value - 1));
+    rowUsed_[ROW_OF[cell]] |= bit;
+    colUsed_[COL_OF[cell]] |= bit;
+    boxUsed_[BOX_OF[cell]] |= bit;
+    board_.setValue(ROW_OF[cell], COL_OF[cell], value);
+    lastCell_ = cell;
+}
+
+void IncrementalSolver::unplace(int cell, int value) {
+    uint16_t bit = static_cast<uint16_t>(~(1 << (value - 1)));
+    rowUsed_[ROW_OF[cell]] &= bit;
+    colUsed_[COL_OF[cell]] &= bit;
+    boxUsed_[BOX_OF[cell]] &= bit;
+    board_.setValue(ROW_OF[cell], COL_OF[cell], 0);
+    lastCell_ = cell;
+}
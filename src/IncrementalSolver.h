@@ -0,0 +1,64 @@
+//incremental.h
+#pragma once
+
+#include "Board.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+// Resumable depth-first solver for animating a solve inside the frame loop.
+// The recursion is unrolled onto an explicit stack, so each step() call
+// places at most maxNodes values or runs for at most maxTime, and the
+// partial board can be drawn between calls. Branches on the cell with the
+// fewest candidates, like BitboardSolver, to keep hard puzzles watchable.
+class IncrementalSolver {
+public:
+    enum class State {
+        IDLE,
+        RUNNING,
+        SOLVED,
+        UNSOLVABLE
+    };
+    
+    IncrementalSolver();
+    
+    // Starts over from the givens of the puzzle; other values are ignored
+    void start(const Board& puzzle);
+    void reset();
+    
+    State step(uint64_t maxNodes, std::chrono::microseconds maxTime);
+    
+    State getState() const;
+    // Givens plus the values placed so far
+    const Board& getBoard() const;
+    uint64_t getNodes() const;
+    // Cell most recently filled or cleared, {-1, -1} before the first step
+    std::pair<int, int> getLastCell() const;
+    
+private:
+    static constexpr int CELL_COUNT = Board::SIZE * Board::SIZE;
+    
+    struct Frame {
+        int cell;
+        uint16_t candidates;  // values not tried yet, bit v-1 for value v
+        int placed;           // value currently in the cell, 0 if none
+    };
+    
+    Board board_;
+    State state_;
+    std::array<Frame, CELL_COUNT> stack_;
+    int depth_;
+    bool descend_;
+    uint64_t nodes_;
+    int lastCell_;
+    
+    std::array<uint16_t, Board::SIZE> rowUsed_;
+    std::array<uint16_t, Board::SIZE> colUsed_;
+    std::array<uint16_t, Board::SIZE> boxUsed_;
+    
+    void advance();
+    bool pickCell(int& cell, uint16_t& candidates) const;
+    void place(int cell, int value);
+    void unplace(int cell, int value);
+};
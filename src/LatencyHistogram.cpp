@@ -0,0 +1,82 @@
+//histogram.cpp
+#include "LatencyHistogram.h"
+#include <algorithm>
+
+LatencyHistogram::LatencyHistogram() : count_(0), sum_(0), max_(0) {
+    buckets_.fill(0);
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    buckets_[bucketOf(micros)]++;
+    count_++;
+    sum_ += micros;
+    max_ = std::max(max_, micros);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int b = 0; b < BUCKETS; ++b) {
+        buckets_[b] += other.buckets_[b];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+}
+
+uint64_t LatencyHistogram::getCount() const {
+    return count_;
+}
+
+uint64_t LatencyHistogram::getSum() const {
+    return sum_;
+}
+
+uint64_t LatencyHistogram::getMax() const {
+    return max_;
+}
+
+uint64_t LatencyHistogram::getPercentile(double quantile) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(quantile * static_cast<double>(count_ - 1)) + 1;
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        seen += buckets_[b];
+        if (seen >= rank) {
+            return std::min(max_, getBucketUpperBound(b));
+        }
+    }
+    return max_;
+}
+
+uint64_t LatencyHistogram::getBucketCount(int bucket) const {
+    return buckets_[bucket];
+}
+
+uint64_t LatencyHistogram::getBucketUpperBound(int bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return static_cast<uint64_t>(bucket);
+    }
+    int shift = bucket / SUB_BUCKETS - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket % SUB_BUCKETS + SUB_BUCKETS);
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::print(std::ostream& out) const {
+    out << "    p50 " << getPercentile(0.5) << "us  p90 " << getPercentile(0.9)
+        << "us  p99 " << getPercentile(0.99) << "us  p99.9 " << getPercentile(0.999)
+        << "us  max " << max_ << "us" << std::endl;
+}
+
+int LatencyHistogram::bucketOf(uint64_t micros) {
+    // Values below SUB_BUCKETS are exact; above that, keep the top
+    // SUB_BUCKET_BITS + 1 bits and index by how far they were shifted
+    if (micros < SUB_BUCKETS) {
+        return static_cast<int>(micros);
+    }
+    int shift = 0;
+    while ((micros >> shift) >= 2 * SUB_BUCKETS) {
+        shift++;
+    }
+    return (shift + 1) * SUB_BUCKETS + static_cast<int>(micros >> shift) - SUB_BUCKETS;
+}
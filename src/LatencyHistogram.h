@@ -0,0 +1,41 @@
+//histogram.h
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+// HDR-style log-linear histogram of microseconds: every power of two is
+// split into SUB_BUCKETS linear buckets, so any recorded value is known to
+// within 1/SUB_BUCKETS of itself. Cheap enough to record from a hot loop.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+    
+    LatencyHistogram();
+    
+    void record(uint64_t micros);
+    void merge(const LatencyHistogram& other);
+    
+    uint64_t getCount() const;
+    uint64_t getSum() const;
+    uint64_t getMax() const;
+    // Upper bound of the bucket holding the given quantile (0-1)
+    uint64_t getPercentile(double quantile) const;
+    
+    uint64_t getBucketCount(int bucket) const;
+    // Largest value that falls into the bucket
+    static uint64_t getBucketUpperBound(int bucket);
+    
+    void print(std::ostream& out) const;
+    
+private:
+    std::array<uint64_t, BUCKETS> buckets_;
+    uint64_t count_;
+    uint64_t sum_;
+    uint64_t max_;
+    
+    static int bucketOf(uint64_t micros);
+};
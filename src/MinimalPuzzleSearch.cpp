@@ -0,0 +1,198 @@
+//minimalsearch.cpp
+#include "MinimalPuzzleSearch.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <vector>
+
+struct MinimalPuzzleSearch::Shared {
+    const MinimalSearchOptions& options;
+    const SearchLimits& limits;
+    
+    std::mutex mutex;
+    bool found = false;
+    Grid bestPuzzle{};
+    Grid bestSolution{};
+    int bestClues = Board::SIZE * Board::SIZE + 1;
+    std::atomic<bool> reachedTarget{false};
+    std::atomic<uint64_t> restarts{0};
+    
+    Shared(const MinimalSearchOptions& searchOptions, const SearchLimits& searchLimits)
+        : options(searchOptions)
+        , limits(searchLimits) {
+    }
+    
+    bool done() const {
+        return reachedTarget.load(std::memory_order_relaxed) || limits.shouldStop();
+    }
+    
+    void offer(const Grid& puzzle, const Grid& solution, int clues) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (clues < bestClues) {
+            found = true;
+            bestPuzzle = puzzle;
+            bestSolution = solution;
+            bestClues = clues;
+            if (clues <= options.targetClues) {
+                reachedTarget = true;
+            }
+        }
+    }
+};
+
+MinimalSearchResult MinimalPuzzleSearch::search(const MinimalSearchOptions& options,
+                                                const SearchLimits& limits) {
+    auto start = std::chrono::steady_clock::now();
+    Shared shared(options, limits);
+    
+    uint32_t seed = options.seed ? *options.seed : std::random_device()();
+    int threads = ThreadPool::resolveThreadCount(options.threads);
+    {
+        ThreadPool pool(threads);
+        std::vector<std::future<void>> workers;
+        for (int i = 0; i < threads; ++i) {
+            workers.push_back(pool.submit([&shared, seed, i]() {
+                runWorker(shared, seed + static_cast<uint32_t>(i) * 0x9E3779B9u);
+            }));
+        }
+        for (auto& worker : workers) {
+            worker.get();
+        }
+    }
+    
+    MinimalSearchResult result;
+    result.found = shared.found;
+    result.minimal = shared.found && isMinimal(shared.bestPuzzle);
+    result.puzzle = BitboardSolver::toBoard(shared.bestPuzzle);
+    result.solution = BitboardSolver::toBoard(shared.bestSolution);
+    result.clueCount = result.found ? shared.bestClues : 0;
+    result.reachedTarget = result.minimal && shared.bestClues <= options.targetClues;
+    result.restarts = shared.restarts;
+    result.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    return result;
+}
+
+bool MinimalPuzzleSearch::isMinimal(const Grid& puzzle) {
+    if (!BitboardSolver::hasUniqueSolution(puzzle)) {
+        return false;
+    }
+    
+    Grid trial = puzzle;
+    for (size_t i = 0; i < trial.size(); ++i) {
+        if (trial[i] == 0) continue;
+        uint8_t value = trial[i];
+        trial[i] = 0;
+        bool unique = BitboardSolver::hasUniqueSolution(trial);
+        trial[i] = value;
+        if (unique) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MinimalPuzzleSearch::runWorker(Shared& shared, uint32_t seed) {
+    std::mt19937 rng(seed);
+    const SearchLimits& limits = shared.limits;
+    
+    while (!shared.done()) {
+        shared.restarts++;
+        
+        Grid solution{};
+        BitboardSolver::randomFill(solution, rng);
+        Grid puzzle = solution;
+        bool minimized = minimize(puzzle, rng, limits);
+        // A pass the limits cut short still leaves a unique puzzle, better
+        // than none when it is all this search gets to
+        int clues = countClues(puzzle);
+        shared.offer(puzzle, solution, clues);
+        if (!minimized) {
+            return;
+        }
+        
+        int stalled = 0;
+        while (stalled < shared.options.stallLimit && !shared.done()) {
+            Grid candidate = puzzle;
+            std::vector<int> given;
+            std::vector<int> empty;
+            for (int i = 0; i < static_cast<int>(candidate.size()); ++i) {
+                (candidate[i] ? given : empty).push_back(i);
+            }
+            
+            if (std::uniform_int_distribution<int>(0, 3)(rng) != 0) {
+                // Clue swap: trade one clue for a cell that keeps the solution unique
+                int out = given[std::uniform_int_distribution<size_t>(0, given.size() - 1)(rng)];
+                int in = empty[std::uniform_int_distribution<size_t>(0, empty.size() - 1)(rng)];
+                candidate[out] = 0;
+                candidate[in] = solution[in];
+                int solutions = BitboardSolver::countSolutions(candidate, 2, nullptr, &limits);
+                if (solutions < 0) {
+                    return;
+                }
+                if (solutions != 1) {
+                    stalled++;
+                    continue;
+                }
+            } else {
+                // Backtrack over the removal order: restore a few removed clues
+                // and remove again in a new random order
+                std::shuffle(empty.begin(), empty.end(), rng);
+                int restore = std::min<int>(std::uniform_int_distribution<int>(2, 4)(rng),
+                                            static_cast<int>(empty.size()));
+                for (int k = 0; k < restore; ++k) {
+                    candidate[empty[k]] = solution[empty[k]];
+                }
+            }
+            
+            if (!minimize(candidate, rng, limits)) {
+                return;
+            }
+            int candidateClues = countClues(candidate);
+            if (candidateClues < clues) {
+                puzzle = candidate;
+                clues = candidateClues;
+                stalled = 0;
+                shared.offer(puzzle, solution, clues);
+            } else {
+                // Sideways moves keep the walk going across plateaus
+                if (candidateClues == clues) {
+                    puzzle = candidate;
+                }
+                stalled++;
+            }
+        }
+    }
+}
+
+bool MinimalPuzzleSearch::minimize(Grid& puzzle, std::mt19937& rng, const SearchLimits& limits) {
+    // One pass suffices: a clue that was needed stays needed as others go
+    std::vector<int> order;
+    for (int i = 0; i < static_cast<int>(puzzle.size()); ++i) {
+        if (puzzle[i] != 0) {
+            order.push_back(i);
+        }
+    }
+    std::shuffle(order.begin(), order.end(), rng);
+    
+    for (int i : order) {
+        uint8_t value = puzzle[i];
+        puzzle[i] = 0;
+        int solutions = BitboardSolver::countSolutions(puzzle, 2, nullptr, &limits);
+        if (solutions < 0) {
+            puzzle[i] = value;
+            return false;
+        }
+        if (solutions != 1) {
+            puzzle[i] = value;
+        }
+    }
+    return true;
+}
+
+int MinimalPuzzleSearch::countClues(const Grid& puzzle) {
+    return static_cast<int>(std::count_if(puzzle.begin(), puzzle.end(),
+                                          [](uint8_t value) { return value != 0; }));
+}
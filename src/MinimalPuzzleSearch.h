@@ -0,0 +1,52 @@
+//minimalsearch.h
+#pragma once
+
+#include "BitboardSolver.h"
+#include "Board.h"
+#include "CancellationToken.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+struct MinimalSearchOptions {
+    int targetClues = 17;
+    int threads = 0;                  // 0 = all cores
+    std::optional<uint32_t> seed;     // worker streams are derived from it
+    int stallLimit = 400;             // local-search steps without progress before a restart
+};
+
+struct MinimalSearchResult {
+    bool found;                       // false if the limits hit before any worker started
+    bool minimal;                     // every clue of the puzzle is necessary
+    Board puzzle;                     // unique; minimal unless the limits cut the first pass short
+    Board solution;
+    int clueCount;
+    bool reachedTarget;
+    uint64_t restarts;
+    std::chrono::microseconds elapsed;
+};
+
+// Searches for low-clue minimal puzzles, where every clue is necessary.
+// Each worker starts from a random grid, removes clues greedily in random
+// order, then improves the puzzle by local search: swapping a clue for
+// another cell, or backtracking over the removal order by restoring a few
+// removed clues, and re-minimising after each move. Workers restart from
+// a fresh grid when they stall and share the best puzzle found.
+class MinimalPuzzleSearch {
+public:
+    using Grid = BitboardSolver::Grid;
+    
+    // Runs until a puzzle with targetClues is found or the limits stop it
+    static MinimalSearchResult search(const MinimalSearchOptions& options,
+                                      const SearchLimits& limits);
+    
+    // Removing any single clue admits a second solution
+    static bool isMinimal(const Grid& puzzle);
+    
+private:
+    struct Shared;
+    
+    static void runWorker(Shared& shared, uint32_t seed);
+    static bool minimize(Grid& puzzle, std::mt19937& rng, const SearchLimits& limits);
+    static int countClues(const Grid& puzzle);
+};
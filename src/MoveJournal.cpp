@@ -0,0 +1,81 @@
+//movejournal.cpp
+#include "MoveJournal.h"
+#include <algorithm>
+
+MoveJournal::MoveJournal(size_t capacity)
+    : deltas_(std::max(capacity, MAX_MOVE_SIZE))
+    , begin_(0)
+    , cursor_(0)
+    , end_(0) {
+}
+
+void MoveJournal::record(const CellDelta* deltas, size_t count) {
+    if (count == 0 || count > MAX_MOVE_SIZE) {
+        return;
+    }
+    
+    end_ = cursor_;
+    while (end_ + count - begin_ > deltas_.size()) {
+        do {
+            ++begin_;
+        } while (begin_ != end_ && !at(begin_).moveStart);
+    }
+    
+    for (size_t i = 0; i < count; ++i) {
+        CellDelta& delta = at(end_ + i);
+        delta = deltas[i];
+        delta.moveStart = i == 0 ? 1 : 0;
+    }
+    end_ += count;
+    cursor_ = end_;
+}
+
+size_t MoveJournal::undo(Move& move) {
+    if (!canUndo()) {
+        return 0;
+    }
+    
+    uint64_t start = cursor_;
+    do {
+        --start;
+    } while (!at(start).moveStart);
+    
+    size_t count = static_cast<size_t>(cursor_ - start);
+    for (size_t i = 0; i < count; ++i) {
+        move[i] = at(start + i);
+    }
+    cursor_ = start;
+    return count;
+}
+
+size_t MoveJournal::redo(Move& move) {
+    if (!canRedo()) {
+        return 0;
+    }
+    
+    size_t count = 0;
+    do {
+        move[count++] = at(cursor_++);
+    } while (cursor_ != end_ && !at(cursor_).moveStart);
+    return count;
+}
+
+bool MoveJournal::canUndo() const {
+    return cursor_ != begin_;
+}
+
+bool MoveJournal::canRedo() const {
+    return cursor_ != end_;
+}
+
+void MoveJournal::clear() {
+    begin_ = cursor_ = end_ = 0;
+}
+
+size_t MoveJournal::getCapacity() const {
+    return deltas_.size();
+}
+
+CellDelta& MoveJournal::at(uint64_t position) {
+    return deltas_[position % deltas_.size()];
+}
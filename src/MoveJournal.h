@@ -0,0 +1,61 @@
+//movejournal.h
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One cell's change within a move, in six bytes
+struct CellDelta {
+    uint8_t cell : 7;          // 0-80, row * 9 + col
+    uint8_t moveStart : 1;     // set on the first delta of each move
+    uint8_t valueBefore : 4;   // 0 = empty
+    uint8_t valueAfter : 4;
+    uint16_t notesBefore;      // bit value-1 per pencil mark
+    uint16_t notesAfter;
+};
+
+static_assert(sizeof(CellDelta) == 6, "CellDelta should pack into six bytes");
+
+// Undo/redo history as a fixed-capacity ring of cell deltas. A move is the
+// run of deltas from one moveStart to the next. Recording past capacity
+// drops the oldest whole moves, so memory stays at capacity * 6 bytes
+// however long the session runs; recording after an undo drops the redo
+// tail. Undo and redo cost the size of the move, never of the history.
+class MoveJournal {
+public:
+    // A move changes each cell at most once
+    static constexpr size_t MAX_MOVE_SIZE = 81;
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+    
+    using Move = std::array<CellDelta, MAX_MOVE_SIZE>;
+    
+    // At least MAX_MOVE_SIZE deltas are kept whatever capacity is asked for
+    explicit MoveJournal(size_t capacity = DEFAULT_CAPACITY);
+    
+    // moveStart is set on the first delta; an empty move is not recorded
+    void record(const CellDelta* deltas, size_t count);
+    
+    // Copy the move into move, in the order it was recorded, and step over
+    // it; 0 if there is nothing to undo or redo
+    size_t undo(Move& move);
+    size_t redo(Move& move);
+    
+    bool canUndo() const;
+    bool canRedo() const;
+    void clear();
+    
+    size_t getCapacity() const;
+    
+private:
+    std::vector<CellDelta> deltas_;
+    // Positions count deltas ever recorded and wrap into deltas_. The kept
+    // history is [begin_, end_), with moves before cursor_ done and the rest
+    // undone; begin_ and cursor_ are always at a move start.
+    uint64_t begin_;
+    uint64_t cursor_;
+    uint64_t end_;
+    
+    CellDelta& at(uint64_t position);
+};
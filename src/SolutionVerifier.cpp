@@ -0,0 +1,125 @@
+//verifier.cpp
+#include "SolutionVerifier.h"
+#include "SudokuTables.h"
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SUDOKU_VERIFIER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr int N = Board::SIZE;
+constexpr int CELLS = N * N;
+constexpr uint16_t ALL_DIGITS = 0x1FF;
+
+// Digit bit for each byte value; anything outside 1-9 maps to 0 and fails
+constexpr std::array<uint16_t, 256> makeDigitBits() {
+    std::array<uint16_t, 256> bits{};
+    for (int v = 1; v <= N; ++v) {
+        bits[v] = static_cast<uint16_t>(1 << (v - 1));
+    }
+    return bits;
+}
+
+constexpr std::array<uint16_t, 256> DIGIT_BITS = makeDigitBits();
+
+bool verifyOne(const uint8_t* grid, const uint8_t* puzzle) {
+    uint16_t bits[CELLS];
+    uint16_t mismatch = 0;
+    for (int i = 0; i < CELLS; ++i) {
+        bits[i] = DIGIT_BITS[grid[i]];
+        mismatch |= DIGIT_BITS[puzzle[i]] & ~bits[i];
+    }
+    
+    uint16_t valid = ALL_DIGITS;
+    for (const auto& unit : SudokuTables::UNITS) {
+        uint16_t acc = 0;
+        for (uint8_t cell : unit) {
+            acc |= bits[cell];
+        }
+        valid &= acc == ALL_DIGITS ? ALL_DIGITS : 0;
+    }
+    return valid == ALL_DIGITS && mismatch == 0;
+}
+
+void setBit(std::vector<uint64_t>& bitmap, size_t index) {
+    bitmap[index / 64] |= uint64_t(1) << (index % 64);
+}
+
+} // namespace
+
+std::vector<uint64_t> SolutionVerifier::verify(const Grid* grids, const Grid* puzzles,
+                                               size_t count) {
+    std::vector<uint64_t> bitmap((count + 63) / 64, 0);
+    verifyRange(grids, puzzles, 1, count, bitmap);
+    return bitmap;
+}
+
+std::vector<uint64_t> SolutionVerifier::verify(const Grid* grids, size_t count,
+                                               const Grid& puzzle) {
+    std::vector<uint64_t> bitmap((count + 63) / 64, 0);
+    verifyRange(grids, &puzzle, 0, count, bitmap);
+    return bitmap;
+}
+
+bool SolutionVerifier::verify(const Grid& grid, const Grid& puzzle) {
+    return verifyOne(grid.data(), puzzle.data());
+}
+
+void SolutionVerifier::verifyRange(const Grid* grids, const Grid* puzzles, size_t puzzleStride,
+                                   size_t count, std::vector<uint64_t>& bitmap) {
+    size_t i = 0;
+    
+#ifdef SUDOKU_VERIFIER_SSE2
+    constexpr size_t LANES = 8;
+    const __m128i allDigits = _mm_set1_epi16(ALL_DIGITS);
+    const __m128i zero = _mm_setzero_si128();
+    
+    for (; i + LANES <= count; i += LANES) {
+        // Cell-major layout: lane k of cells[c] is cell c of grid i + k
+        alignas(16) uint16_t lanes[CELLS][LANES];
+        alignas(16) uint16_t givens[CELLS][LANES];
+        for (size_t k = 0; k < LANES; ++k) {
+            const uint8_t* grid = grids[i + k].data();
+            const uint8_t* puzzle = puzzles[(i + k) * puzzleStride].data();
+            for (int c = 0; c < CELLS; ++c) {
+                lanes[c][k] = DIGIT_BITS[grid[c]];
+                givens[c][k] = DIGIT_BITS[puzzle[c]];
+            }
+        }
+        
+        __m128i cells[CELLS];
+        __m128i mismatch = zero;
+        for (int c = 0; c < CELLS; ++c) {
+            cells[c] = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes[c]));
+            __m128i given = _mm_load_si128(reinterpret_cast<const __m128i*>(givens[c]));
+            mismatch = _mm_or_si128(mismatch, _mm_andnot_si128(cells[c], given));
+        }
+        
+        __m128i valid = _mm_cmpeq_epi16(mismatch, zero);
+        for (const auto& unit : SudokuTables::UNITS) {
+            __m128i acc = cells[unit[0]];
+            for (int j = 1; j < N; ++j) {
+                acc = _mm_or_si128(acc, cells[unit[j]]);
+            }
+            valid = _mm_and_si128(valid, _mm_cmpeq_epi16(acc, allDigits));
+        }
+        
+        // Two mask bits per 16-bit lane
+        int mask = _mm_movemask_epi8(valid);
+        for (size_t k = 0; k < LANES; ++k) {
+            if (mask & (1 << (2 * k))) {
+                setBit(bitmap, i + k);
+            }
+        }
+    }
+#endif
+    
+    for (; i < count; ++i) {
+        if (verifyOne(grids[i].data(), puzzles[i * puzzleStride].data())) {
+            setBit(bitmap, i);
+        }
+    }
+}
@@ -0,0 +1,28 @@
+//verifier.h
+#pragma once
+
+#include "BitboardSolver.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Checks completed grids in bulk. Every row, column and box must OR its
+// cells' digit bits to 0x1FF, and every given of the puzzle must be kept.
+// With SSE2, eight grids are checked at once, one per 16-bit lane;
+// other targets use the same logic one grid at a time.
+class SolutionVerifier {
+public:
+    using Grid = BitboardSolver::Grid;
+    
+    // Bit i of the returned bitmap (word i / 64, bit i % 64) is set if
+    // grids[i] is a valid solution of puzzles[i]
+    static std::vector<uint64_t> verify(const Grid* grids, const Grid* puzzles, size_t count);
+    // All submissions answer the same puzzle
+    static std::vector<uint64_t> verify(const Grid* grids, size_t count, const Grid& puzzle);
+    
+    static bool verify(const Grid& grid, const Grid& puzzle);
+    
+private:
+    static void verifyRange(const Grid* grids, const Grid* puzzles, size_t puzzleStride,
+                            size_t count, std::vector<uint64_t>& bitmap);
+};
@@ -0,0 +1,681 @@
+//fuzzer.cpp
+#include "SolverFuzzer.h"
+#include "IncrementalSolver.h"
+#include "SolutionVerifier.h"
+#include "SudokuSolver.h"
+#include "SudokuTables.h"
+#include "SudokuTransformer.h"
+#include "SudokuVariant.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+#include "VariantGenerator.h"
+#include "VariantSolver.h"
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+using Grid = BitboardSolver::Grid;
+
+constexpr int N = Board::SIZE;
+constexpr int CELLS = N * N;
+
+// Well-known hard puzzles. They are shuffled before use, so they do not
+// always hit the reference backtracker's worst case.
+const char* const HARD_PUZZLES[] = {
+    "100007090030020008009600500005300900010080002600004000300000010040000007007000300",
+    "000000012000000003002300400001800005060070800000009000008500000900040500470006000",
+    "000000039000001005003050800008090006070002000100400000009080050020000600400700000",
+    "000000000000003085001020000000507000004000100090000000500000073002010000000040009"
+};
+
+struct Outcome {
+    enum class Kind {
+        COUNT,     // solutions is exact up to 2
+        SOLVABLE,  // solutions is only 0 or 1
+        TIMEOUT
+    };
+    
+    Kind kind = Kind::TIMEOUT;
+    int solutions = 0;
+    bool hasSolution = false;
+    Grid solution{};
+};
+
+struct Engine {
+    const char* name;
+    std::function<Outcome(const Grid&, const SearchLimits&)> run;
+};
+
+Outcome fromResult(SudokuSolver::Result result, Outcome::Kind kind) {
+    Outcome outcome;
+    switch (result) {
+        case SudokuSolver::Result::SOLVED:
+            outcome.kind = kind;
+            outcome.solutions = 1;
+            break;
+        case SudokuSolver::Result::MULTIPLE_SOLUTIONS:
+            outcome.kind = kind;
+            outcome.solutions = kind == Outcome::Kind::COUNT ? 2 : 1;
+            break;
+        case SudokuSolver::Result::UNSOLVABLE:
+            outcome.kind = kind;
+            break;
+        default:
+            break;
+    }
+    return outcome;
+}
+
+Outcome fromCount(int count, const Grid* solution) {
+    Outcome outcome;
+    if (count >= 0) {
+        outcome.kind = Outcome::Kind::COUNT;
+        outcome.solutions = count;
+        if (count > 0 && solution) {
+            outcome.hasSolution = true;
+            outcome.solution = *solution;
+        }
+    }
+    return outcome;
+}
+
+std::string toText(const Grid& grid) {
+    std::string text(CELLS, '0');
+    for (int i = 0; i < CELLS; ++i) {
+        text[i] = static_cast<char>('0' + grid[i]);
+    }
+    return text;
+}
+
+std::string describe(const Outcome& outcome) {
+    if (outcome.kind == Outcome::Kind::COUNT) {
+        return outcome.solutions >= 2 ? "multiple" : std::to_string(outcome.solutions) + " solutions";
+    }
+    return outcome.solutions ? "solvable" : "unsolvable";
+}
+
+bool isFilled(const Grid& grid) {
+    return std::find(grid.begin(), grid.end(), 0) == grid.end();
+}
+
+// Plain backtracking over a variant that reads its unit and cage lists
+// directly, with none of VariantSolver's masks, peer sets or cage digit
+// tables, so the two share no bookkeeping that could be wrong the same way
+struct VariantReference {
+    const SudokuVariant& variant;
+    const SearchLimits& limits;
+    std::vector<std::vector<int>> unitsOf;
+    Grid cells{};
+    int count = 0;
+    uint64_t nodes = 0;
+    bool aborted = false;
+    
+    VariantReference(const SudokuVariant& rules, const SearchLimits& searchLimits)
+        : variant(rules)
+        , limits(searchLimits)
+        , unitsOf(CELLS) {
+        for (int unit = 0; unit < variant.getUnitCount(); ++unit) {
+            for (uint8_t cell : variant.getUnit(unit)) {
+                unitsOf[cell].push_back(unit);
+            }
+        }
+    }
+    
+    // The value breaks no unit or cage given the rest of the grid
+    bool allowed(int cell, int value) const {
+        for (int unit : unitsOf[cell]) {
+            for (uint8_t other : variant.getUnit(unit)) {
+                if (other != cell && cells[other] == value) return false;
+            }
+        }
+        int cage = variant.getCageOf(cell);
+        if (cage < 0) return true;
+        
+        // Every cage cell still empty needs at least 1
+        const Cage& rules = variant.getCages()[cage];
+        int sum = value;
+        int empty = 0;
+        for (uint8_t other : rules.cells) {
+            if (other == cell) continue;
+            if (cells[other] == value) return false;
+            sum += cells[other];
+            empty += cells[other] == 0;
+        }
+        return empty == 0 ? sum == rules.sum : sum + empty <= rules.sum;
+    }
+    
+    // Up to two solutions, or -1 if the limits stopped it
+    int countSolutions(const Grid& grid) {
+        cells = grid;
+        for (int cell = 0; cell < CELLS; ++cell) {
+            if (cells[cell] > N || (cells[cell] != 0 && !allowed(cell, cells[cell]))) {
+                return 0;
+            }
+        }
+        search();
+        return aborted ? -1 : count;
+    }
+    
+    void search() {
+        if (++nodes % SearchLimits::NODES_PER_CHECK == 0 && limits.shouldStop()) {
+            aborted = true;
+        }
+        if (aborted || count >= 2) return;
+        
+        int best = -1;
+        int bestOptions = N + 1;
+        for (int cell = 0; cell < CELLS && bestOptions > 1; ++cell) {
+            if (cells[cell] != 0) continue;
+            int options = 0;
+            for (int value = 1; value <= N; ++value) {
+                options += allowed(cell, value);
+            }
+            if (options < bestOptions) {
+                best = cell;
+                bestOptions = options;
+            }
+        }
+        if (best == -1) {
+            count++;
+            return;
+        }
+        for (int value = 1; value <= N && !aborted && count < 2; ++value) {
+            if (!allowed(best, value)) continue;
+            cells[best] = static_cast<uint8_t>(value);
+            search();
+            cells[best] = 0;
+        }
+    }
+    
+    // A full grid that keeps the givens and breaks no unit or cage
+    bool solves(const Grid& solution, const Grid& puzzle) {
+        cells = solution;
+        for (int cell = 0; cell < CELLS; ++cell) {
+            if (cells[cell] == 0 || cells[cell] > N || (puzzle[cell] != 0 && puzzle[cell] != cells[cell]) ||
+                !allowed(cell, cells[cell])) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+FuzzReport SolverFuzzer::run(const FuzzOptions& options) {
+    FuzzReport report;
+    report.seed = options.seed ? *options.seed : std::random_device()();
+    std::mt19937 rng(report.seed);
+    
+    ThreadPool pool(options.threads);
+    TranspositionTable table;  // shared across boards, like the generator's removal trials
+    SudokuVariant classic = SudokuVariant::classic();
+    std::mt19937 solveRng(report.seed);
+    
+    std::vector<Engine> engines = {
+        {"backtrack-count", [](const Grid& grid, const SearchLimits& limits) {
+            return fromResult(SudokuSolver::countSolutions(BitboardSolver::toBoard(grid), 2,
+                                                           nullptr, &limits),
+                              Outcome::Kind::COUNT);
+        }},
+        {"backtrack-count-tt", [&table](const Grid& grid, const SearchLimits& limits) {
+            return fromResult(SudokuSolver::countSolutions(BitboardSolver::toBoard(grid), 2,
+                                                           &table, &limits),
+                              Outcome::Kind::COUNT);
+        }},
+        {"backtrack-solve", [&solveRng](const Grid& grid, const SearchLimits& limits) {
+            Board board = BitboardSolver::toBoard(grid);
+            Outcome outcome = fromResult(SudokuSolver::solve(board, solveRng, &limits),
+                                         Outcome::Kind::SOLVABLE);
+            outcome.hasSolution = outcome.solutions > 0;
+            outcome.solution = BitboardSolver::fromBoard(board);
+            return outcome;
+        }},
+        {"parallel-count", [&pool](const Grid& grid, const SearchLimits& limits) {
+            return fromResult(SudokuSolver::countSolutions(BitboardSolver::toBoard(grid), 2,
+                                                           pool, &limits),
+                              Outcome::Kind::COUNT);
+        }},
+        {"parallel-solve", [&pool](const Grid& grid, const SearchLimits& limits) {
+            Board board = BitboardSolver::toBoard(grid);
+            Outcome outcome = fromResult(SudokuSolver::solve(board, pool, &limits),
+                                         Outcome::Kind::SOLVABLE);
+            outcome.hasSolution = outcome.solutions > 0;
+            outcome.solution = BitboardSolver::fromBoard(board);
+            return outcome;
+        }},
+        {"bitboard-count", [](const Grid& grid, const SearchLimits& limits) {
+            Grid solution;
+            int count = BitboardSolver::countSolutions(grid, 2, &solution, &limits);
+            return fromCount(count, &solution);
+        }},
+        {"bitboard-enumerate", [](const Grid& grid, const SearchLimits& limits) {
+            Grid solution;
+            EnumerationResult result = BitboardSolver::enumerate(grid, 2, [&solution](const Grid& found) {
+                solution = found;
+                return true;
+            }, &limits);
+            return fromCount(result.aborted ? -1 : static_cast<int>(result.solutions), &solution);
+        }},
+        {"bitboard-enumerate-parallel", [&pool](const Grid& grid, const SearchLimits& limits) {
+            EnumerationResult result = BitboardSolver::enumerate(grid, 2, pool,
+                                                                 BitboardSolver::SolutionVisitor(),
+                                                                 &limits);
+            return fromCount(result.aborted ? -1 : static_cast<int>(result.solutions), nullptr);
+        }},
+        {"incremental", [](const Grid& grid, const SearchLimits& limits) {
+            IncrementalSolver solver;
+            solver.start(BitboardSolver::toBoard(grid));
+            IncrementalSolver::State state = solver.getState();
+            while (state == IncrementalSolver::State::RUNNING && !limits.shouldStop()) {
+                state = solver.step(SudokuSolver::NODES_PER_LIMIT_CHECK, std::chrono::hours(1));
+            }
+            
+            Outcome outcome;
+            if (state != IncrementalSolver::State::RUNNING) {
+                outcome.kind = Outcome::Kind::SOLVABLE;
+                outcome.solutions = state == IncrementalSolver::State::SOLVED ? 1 : 0;
+                outcome.hasSolution = outcome.solutions > 0;
+                outcome.solution = BitboardSolver::fromBoard(solver.getBoard());
+            }
+            return outcome;
+        }},
+        {"variant-classic", [&classic](const Grid& grid, const SearchLimits& limits) {
+            Grid solution;
+            int count = VariantSolver::countSolutions(classic, grid, 2, &solution, &limits);
+            return fromCount(count, &solution);
+        }}
+    };
+    
+    for (const Engine& engine : engines) {
+        FuzzEngineStats stats;
+        stats.name = engine.name;
+        report.engines.push_back(stats);
+    }
+    
+    auto fail = [&report, &options](const std::string& line) {
+        report.mismatches++;
+        if (report.failures.size() < options.maxReportedFailures) {
+            report.failures.push_back(line);
+        }
+    };
+    
+    // Reference solutions and their puzzles, for the bulk verifier check
+    std::vector<Grid> solved;
+    std::vector<Grid> solvedPuzzles;
+    
+    for (size_t b = 0; b < options.boards; ++b) {
+        BoardKind kind = static_cast<BoardKind>(b % report.boardsByKind.size());
+        Grid grid = makeBoard(kind, rng);
+        report.boards++;
+        report.boardsByKind[static_cast<size_t>(kind)]++;
+        
+        std::vector<Outcome> outcomes(engines.size());
+        for (size_t e = 0; e < engines.size(); ++e) {
+            FuzzEngineStats& stats = report.engines[e];
+            SearchLimits limits;
+            limits.deadline = std::chrono::steady_clock::now() + options.timeLimit;
+            
+            auto start = std::chrono::steady_clock::now();
+            outcomes[e] = engines[e].run(grid, limits);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            
+            stats.runs++;
+            stats.busy += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+            stats.latency.record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+            if (outcomes[e].kind == Outcome::Kind::TIMEOUT) {
+                stats.timeouts++;
+            }
+        }
+        
+        // The backtracker if it finished, else the first engine with an exact count
+        auto found = std::find_if(outcomes.begin(), outcomes.end(), [](const Outcome& outcome) {
+            return outcome.kind == Outcome::Kind::COUNT;
+        });
+        Outcome reference;
+        std::string referenceName;
+        if (found == outcomes.end()) {
+            report.unreferenced++;
+        } else {
+            reference = *found;
+            size_t index = static_cast<size_t>(found - outcomes.begin());
+            if (index != 0) {
+                report.fallbackReferences++;
+                referenceName = std::string(" (per ") + engines[index].name + ")";
+            }
+        }
+        
+        for (size_t e = 0; e < engines.size(); ++e) {
+            const Outcome& outcome = outcomes[e];
+            if (outcome.kind == Outcome::Kind::TIMEOUT) continue;
+            
+            std::string problem;
+            if (reference.kind == Outcome::Kind::COUNT) {
+                Outcome expected = reference;
+                if (outcome.kind == Outcome::Kind::SOLVABLE) {
+                    expected.kind = Outcome::Kind::SOLVABLE;
+                    expected.solutions = std::min(expected.solutions, 1);
+                }
+                if (outcome.solutions != expected.solutions) {
+                    problem = "expected " + describe(expected) + referenceName + ", got " +
+                              describe(outcome);
+                }
+            }
+            if (problem.empty() && outcome.hasSolution && outcome.solutions > 0 &&
+                (!isFilled(outcome.solution) || !SolutionVerifier::verify(outcome.solution, grid))) {
+                problem = "returned " + toText(outcome.solution) + ", which does not solve it";
+            }
+            if (!problem.empty()) {
+                report.engines[e].mismatches++;
+                fail(std::string(engines[e].name) + " on " + getBoardKindName(kind) + " " +
+                     toText(grid) + ": " + problem);
+            }
+        }
+        
+        // The reference count carries no grid; take one from an engine that verified
+        if (reference.kind == Outcome::Kind::COUNT && reference.solutions > 0) {
+            Grid solution = grid;
+            if (BitboardSolver::countSolutions(grid, 1, &solution) == 1 &&
+                SolutionVerifier::verify(solution, grid)) {
+                solved.push_back(solution);
+                solvedPuzzles.push_back(grid);
+            }
+        }
+    }
+    
+    // Every reference solution must pass, and the same grid with two cells of
+    // a row swapped must not: the swap puts a duplicate into both columns
+    FuzzEngineStats verifier;
+    verifier.name = "verifier-bulk";
+    if (!solved.empty()) {
+        size_t count = solved.size();
+        std::vector<Grid> submitted(solved);
+        std::vector<Grid> puzzles(solvedPuzzles);
+        for (size_t i = 0; i < count; ++i) {
+            Grid corrupted = solved[i];
+            std::uniform_int_distribution<int> cellDist(0, CELLS - 1);
+            int a = cellDist(rng);
+            int row = SudokuTables::ROW_OF[a];
+            int b = row * N + (SudokuTables::COL_OF[a] + 1 + static_cast<int>(rng() % (N - 1))) % N;
+            std::swap(corrupted[a], corrupted[b]);
+            submitted.push_back(corrupted);
+            puzzles.push_back(solvedPuzzles[i]);
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        std::vector<uint64_t> bitmap = SolutionVerifier::verify(submitted.data(), puzzles.data(),
+                                                                submitted.size());
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        verifier.runs = submitted.size();
+        verifier.busy = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+        verifier.latency.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+        
+        for (size_t i = 0; i < submitted.size(); ++i) {
+            bool accepted = (bitmap[i / 64] >> (i % 64)) & 1;
+            bool expected = i < count;
+            if (accepted != expected ||
+                accepted != SolutionVerifier::verify(submitted[i], puzzles[i])) {
+                verifier.mismatches++;
+                fail(std::string("verifier-bulk on ") + toText(puzzles[i]) + ": " +
+                     (accepted ? "accepted " : "rejected ") + toText(submitted[i]));
+            }
+        }
+    }
+    report.engines.push_back(verifier);
+    
+    runVariants(options, rng, report, fail);
+    return report;
+}
+
+void SolverFuzzer::runVariants(const FuzzOptions& options, std::mt19937& rng, FuzzReport& report,
+                               const std::function<void(const std::string&)>& fail) {
+    const char* const names[] = {"diagonal", "hyper", "jigsaw", "killer"};
+    for (const char* name : names) {
+        FuzzEngineStats stats;
+        stats.name = std::string("variant-") + name;
+        
+        for (size_t b = 0; b < options.variantBoards; ++b) {
+            GeneratorOptions generatorOptions;
+            generatorOptions.seed = static_cast<uint32_t>(rng());
+            // Expert killers have no givens, which leaves nothing to mutate
+            Difficulty difficulty = static_cast<Difficulty>(rng() % 3);
+            VariantPuzzle generated;
+            if (name == names[0]) {
+                generated = VariantGenerator::generate(SudokuVariant::diagonal(), difficulty, generatorOptions);
+            } else if (name == names[1]) {
+                generated = VariantGenerator::generate(SudokuVariant::hyper(), difficulty, generatorOptions);
+            } else if (name == names[2]) {
+                generated = VariantGenerator::generateJigsaw(difficulty, generatorOptions);
+            } else {
+                generated = VariantGenerator::generateKiller(SudokuVariant::classic(), difficulty,
+                                                             generatorOptions);
+            }
+            if (generated.clueCount == 0) continue;
+            
+            // As generated (unique), with a few clues cleared, or with one changed
+            Grid grid = generated.puzzle;
+            std::vector<int> givens;
+            for (int cell = 0; cell < CELLS; ++cell) {
+                if (grid[cell] != 0) givens.push_back(cell);
+            }
+            std::shuffle(givens.begin(), givens.end(), rng);
+            size_t mutation = b % 3;
+            if (mutation == 1) {
+                size_t cleared = std::min<size_t>(1 + rng() % 4, givens.size());
+                for (size_t k = 0; k < cleared; ++k) {
+                    grid[givens[k]] = 0;
+                }
+            } else if (mutation == 2 && !givens.empty()) {
+                grid[givens[0]] = static_cast<uint8_t>(1 + (grid[givens[0]] + rng() % (N - 1)) % N);
+            }
+            report.variantBoards++;
+            
+            SearchLimits limits;
+            limits.deadline = std::chrono::steady_clock::now() + options.timeLimit;
+            auto start = std::chrono::steady_clock::now();
+            Grid solution{};
+            int count = VariantSolver::countSolutions(generated.variant, grid, 2, &solution, &limits);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            stats.runs++;
+            stats.busy += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+            stats.latency.record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+            if (count < 0) {
+                stats.timeouts++;
+                continue;
+            }
+            
+            SearchLimits referenceLimits;
+            referenceLimits.deadline = std::chrono::steady_clock::now() + options.timeLimit;
+            VariantReference reference(generated.variant, referenceLimits);
+            int expected = reference.countSolutions(grid);
+            
+            std::string problem;
+            if (expected < 0) {
+                report.unreferenced++;
+            } else if (count != expected) {
+                problem = "expected " + std::to_string(expected) + " solutions, got " +
+                          std::to_string(count);
+            }
+            if (problem.empty() && count > 0 && !reference.solves(solution, grid)) {
+                problem = "returned " + toText(solution) + ", which does not solve it";
+            }
+            if (problem.empty() && mutation == 0 && solution != generated.solution) {
+                problem = "solved the generated puzzle to " + toText(solution) +
+                          ", not its solution " + toText(generated.solution);
+            }
+            if (!problem.empty()) {
+                stats.mismatches++;
+                fail(stats.name + " on " + toText(grid) + ": " + problem);
+            }
+        }
+        report.engines.push_back(stats);
+    }
+}
+
+void SolverFuzzer::print(const FuzzReport& report, std::ostream& out) {
+    out << "seed " << report.seed << ", " << report.boards << " boards (";
+    for (size_t k = 0; k < report.boardsByKind.size(); ++k) {
+        out << (k ? ", " : "") << report.boardsByKind[k] << " "
+            << getBoardKindName(static_cast<BoardKind>(k));
+    }
+    out << ")";
+    if (report.variantBoards > 0) {
+        out << " and " << report.variantBoards << " variant boards";
+    }
+    out << std::endl;
+    if (report.fallbackReferences > 0 || report.unreferenced > 0) {
+        out << "  reference timed out on " << (report.fallbackReferences + report.unreferenced)
+            << " boards: " << report.fallbackReferences << " checked against the first exact count, "
+            << report.unreferenced << " with no reference" << std::endl;
+    }
+    
+    for (const FuzzEngineStats& stats : report.engines) {
+        double seconds = std::chrono::duration<double>(stats.busy).count();
+        out << "  " << std::left << std::setw(28) << stats.name << std::right
+            << std::setw(10) << static_cast<uint64_t>(stats.runs / std::max(seconds, 1e-9))
+            << " boards/s  " << stats.timeouts << " timeouts  "
+            << stats.mismatches << " mismatches" << std::endl;
+        // The bulk verifier is timed as one call
+        if (stats.latency.getCount() > 1) {
+            stats.latency.print(out);
+        }
+    }
+    
+    for (const std::string& failure : report.failures) {
+        out << "MISMATCH " << failure << std::endl;
+    }
+    if (report.mismatches > report.failures.size()) {
+        out << "... " << (report.mismatches - report.failures.size()) << " more" << std::endl;
+    }
+    out << (report.mismatches == 0 ? "all engines agree" : "engines disagree") << std::endl;
+}
+
+const char* SolverFuzzer::getBoardKindName(BoardKind kind) {
+    switch (kind) {
+        case BoardKind::RANDOM:
+            return "random";
+        case BoardKind::SPARSE:
+            return "sparse";
+        case BoardKind::GENERATED:
+            return "generated";
+        case BoardKind::ADVERSARIAL:
+            return "adversarial";
+        default:
+            return "unknown";
+    }
+}
+
+SolverFuzzer::Grid SolverFuzzer::makeBoard(BoardKind kind, std::mt19937& rng) {
+    Grid grid{};
+    std::uniform_int_distribution<int> cellDist(0, CELLS - 1);
+    std::uniform_int_distribution<int> digitDist(1, N);
+    
+    switch (kind) {
+        case BoardKind::RANDOM: {
+            int clues = std::uniform_int_distribution<int>(0, 30)(rng);
+            for (int i = 0; i < clues; ++i) {
+                grid[cellDist(rng)] = static_cast<uint8_t>(digitDist(rng));
+            }
+            break;
+        }
+        case BoardKind::SPARSE: {
+            int clues = std::uniform_int_distribution<int>(0, 24)(rng);
+            for (int i = 0; i < clues; ++i) {
+                int cell = cellDist(rng);
+                int value = digitDist(rng);
+                if (grid[cell] == 0 && VariantSolver::isValidPlacement(SudokuVariant::classic(),
+                                                                       grid, cell, value)) {
+                    grid[cell] = static_cast<uint8_t>(value);
+                }
+            }
+            break;
+        }
+        case BoardKind::GENERATED: {
+            BitboardSolver::randomFill(grid, rng);
+            int clues = std::uniform_int_distribution<int>(17, 45)(rng);
+            std::array<int, CELLS> order;
+            for (int i = 0; i < CELLS; ++i) {
+                order[i] = i;
+            }
+            std::shuffle(order.begin(), order.end(), rng);
+            for (int i = clues; i < CELLS; ++i) {
+                grid[order[i]] = 0;
+            }
+            break;
+        }
+        case BoardKind::ADVERSARIAL:
+            grid = makeAdversarial(rng);
+            break;
+    }
+    return grid;
+}
+
+SolverFuzzer::Grid SolverFuzzer::makeAdversarial(std::mt19937& rng) {
+    std::uniform_int_distribution<int> cellDist(0, CELLS - 1);
+    Grid grid{};
+    
+    switch (std::uniform_int_distribution<int>(0, 5)(rng)) {
+        case 0: {
+            // Two equal givens in one unit, the rest a plausible puzzle
+            Grid full{};
+            BitboardSolver::randomFill(full, rng);
+            for (int i = 0; i < CELLS; ++i) {
+                grid[i] = rng() % 3 == 0 ? full[i] : 0;
+            }
+            int a = cellDist(rng);
+            const auto& peers = SudokuTables::PEERS[a];
+            int b = peers[rng() % peers.size()];
+            grid[a] = full[a];
+            grid[b] = full[a];
+            break;
+        }
+        case 1: {
+            // A clue changed to another digit its peers allow: locally
+            // consistent, usually unsolvable deep in the search
+            Grid full{};
+            BitboardSolver::randomFill(full, rng);
+            for (int i = 0; i < CELLS; ++i) {
+                grid[i] = rng() % 3 == 0 ? full[i] : 0;
+            }
+            int cell = cellDist(rng);
+            for (int value = 1; value <= N; ++value) {
+                grid[cell] = 0;
+                if (value != full[cell] &&
+                    VariantSolver::isValidPlacement(SudokuVariant::classic(), grid, cell, value)) {
+                    grid[cell] = static_cast<uint8_t>(value);
+                    break;
+                }
+            }
+            break;
+        }
+        case 2:
+            // Complete and valid
+            BitboardSolver::randomFill(grid, rng);
+            break;
+        case 3: {
+            // Complete except for one clashing cell
+            BitboardSolver::randomFill(grid, rng);
+            int a = cellDist(rng);
+            grid[a] = static_cast<uint8_t>(grid[a] % N + 1);
+            break;
+        }
+        case 4:
+            // Empty: the widest possible search for a second solution
+            break;
+        default: {
+            Board puzzle;
+            Board::fromString(HARD_PUZZLES[rng() % (sizeof(HARD_PUZZLES) / sizeof(HARD_PUZZLES[0]))],
+                              puzzle);
+            grid = BitboardSolver::fromBoard(
+                SudokuTransformer::apply(puzzle, SudokuTransform::random(rng)));
+            break;
+        }
+    }
+    return grid;
+}
@@ -0,0 +1,83 @@
+//fuzzer.h
+#pragma once
+
+#include "BitboardSolver.h"
+#include "LatencyHistogram.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+struct FuzzOptions {
+    size_t boards = 1000;
+    // Same seed, same boards; unset draws one from std::random_device
+    std::optional<uint32_t> seed;
+    int threads = 0;  // pool for the parallel engines, 0 = all cores
+    // Per engine and board; a slower run counts as a timeout, not a mismatch
+    std::chrono::milliseconds timeLimit{1000};
+    // Generated puzzles per non-classic variant (X, hyper, jigsaw, killer),
+    // some with clues cleared or changed, checked against a plain backtracker
+    size_t variantBoards = 100;
+    size_t maxReportedFailures = 20;
+};
+
+struct FuzzEngineStats {
+    std::string name;
+    uint64_t runs = 0;
+    uint64_t timeouts = 0;
+    uint64_t mismatches = 0;
+    std::chrono::nanoseconds busy{0};
+    LatencyHistogram latency;
+};
+
+struct FuzzReport {
+    uint32_t seed = 0;
+    size_t boards = 0;
+    std::array<size_t, 4> boardsByKind{};
+    size_t variantBoards = 0;
+    uint64_t mismatches = 0;
+    // Boards the reference timed out on, checked against the first engine
+    // with an exact count instead
+    size_t fallbackReferences = 0;
+    // Boards no counting engine finished; only returned solutions were checked
+    size_t unreferenced = 0;
+    std::vector<std::string> failures;  // the first few, one line each
+    std::vector<FuzzEngineStats> engines;
+};
+
+// Differential check of every solving path against the reference
+// backtracker, SudokuSolver::countSolutions. When it times out, the first
+// engine that did produce an exact count stands in. Engines that count are
+// compared up to two solutions, solve-only engines on whether a solution
+// exists, and every returned solution must complete the board. The bulk
+// SolutionVerifier is checked on good and corrupted solutions at the end.
+// VariantSolver is then checked on every non-classic variant against a
+// plain backtracker that reads the variant's unit and cage lists directly.
+// All engines see the same boards, so the timings are comparable.
+class SolverFuzzer {
+public:
+    enum class BoardKind {
+        RANDOM = 0,       // digits dropped anywhere, mostly contradictory
+        SPARSE = 1,       // a few clues that pass the placement check
+        GENERATED = 2,    // a full grid with cells cleared, always solvable
+        ADVERSARIAL = 3   // clashing or corrupted clues, full grids, hard puzzles
+    };
+    
+    static FuzzReport run(const FuzzOptions& options);
+    static void print(const FuzzReport& report, std::ostream& out);
+    
+    static const char* getBoardKindName(BoardKind kind);
+    
+private:
+    using Grid = BitboardSolver::Grid;
+    
+    static Grid makeBoard(BoardKind kind, std::mt19937& rng);
+    static Grid makeAdversarial(std::mt19937& rng);
+    static void runVariants(const FuzzOptions& options, std::mt19937& rng, FuzzReport& report,
+                            const std::function<void(const std::string&)>& fail);
+};
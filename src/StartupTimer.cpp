@@ -0,0 +1,34 @@
+//startuptimer.cpp
+#include "StartupTimer.h"
+#include <algorithm>
+#include <iomanip>
+
+StartupTimer::StartupTimer()
+    : start_(std::chrono::steady_clock::now()) {
+}
+
+void StartupTimer::mark(const std::string& milestone) {
+    if (hasMark(milestone)) {
+        return;
+    }
+    marks_.emplace_back(milestone, std::chrono::duration_cast<std::chrono::microseconds>(
+                                       std::chrono::steady_clock::now() - start_));
+}
+
+bool StartupTimer::hasMark(const std::string& milestone) const {
+    return std::any_of(marks_.begin(), marks_.end(),
+                       [&milestone](const auto& mark) { return mark.first == milestone; });
+}
+
+void StartupTimer::report(std::ostream& out) const {
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << "startup:";
+    for (size_t i = 0; i < marks_.size(); ++i) {
+        out << (i == 0 ? " " : ", ") << marks_[i].first << " " << std::fixed << std::setprecision(1)
+            << marks_[i].second.count() / 1000.0 << "ms";
+    }
+    out << std::endl;
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,27 @@
+//startuptimer.h
+#pragma once
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Time from launch to each startup milestone (window shown, game ready,
+// first frame, font loaded), reported on one line to track cold start
+class StartupTimer {
+public:
+    // Times are measured from construction, the first thing main does
+    StartupTimer();
+    
+    // Later marks of a milestone already recorded are ignored
+    void mark(const std::string& milestone);
+    bool hasMark(const std::string& milestone) const;
+    
+    // "startup: window 41.2ms, game 0.3ms, ..." with times since launch
+    void report(std::ostream& out) const;
+    
+private:
+    std::chrono::steady_clock::time_point start_;
+    std::vector<std::pair<std::string, std::chrono::microseconds>> marks_;
+};
@@ -0,0 +1,242 @@
+//canonicalizer.cpp
+#include "SudokuCanonicalizer.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr int N = Board::SIZE;
+constexpr int B = Board::BOX_SIZE;
+
+constexpr int PERMS3[6][3] = {
+    {0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}
+};
+
+// Digit relabelling built in order of first appearance, which is the
+// lexicographically smallest labelling for a fixed cell order
+struct Labels {
+    std::array<uint8_t, N + 1> map{};
+    uint8_t next = 0;
+};
+
+} // namespace
+
+struct SudokuCanonicalizer::Search {
+    Grid source;
+    std::array<int, N> colMap;
+    Grid current;
+    Grid best;
+    bool haveBest = false;
+
+    void buildRow(int srcRow, Labels& labels, uint8_t* out) const {
+        for (int c = 0; c < N; ++c) {
+            uint8_t v = source[srcRow * N + colMap[c]];
+            if (v != 0) {
+                if (labels.map[v] == 0) {
+                    labels.map[v] = ++labels.next;
+                }
+                v = labels.map[v];
+            }
+            out[c] = v;
+        }
+    }
+
+    void searchRows(int depth, int usedRows, int band, const Labels& labels) {
+        int prefix = depth * N;
+        int cmp = haveBest ? std::memcmp(current.data(), best.data(), prefix) : -1;
+        if (cmp > 0) {
+            return;
+        }
+        if (depth == N) {
+            if (cmp < 0) {
+                best = current;
+                haveBest = true;
+            }
+            return;
+        }
+
+        // Only the siblings producing the smallest next row can lead to the minimum
+        uint8_t minRow[N];
+        int candidates[N];
+        Labels candidateLabels[N];
+        int candidateCount = 0;
+
+        for (int r = 0; r < N; ++r) {
+            if (usedRows & (1 << r)) continue;
+            if (depth % B == 0) {
+                if (usedRows & (0x7 << (r / B * B))) continue; // band already placed
+            } else if (r / B != band) {
+                continue;
+            }
+
+            Labels next = labels;
+            uint8_t row[N];
+            buildRow(r, next, row);
+
+            int rowCmp = candidateCount == 0 ? -1 : std::memcmp(row, minRow, N);
+            if (rowCmp < 0) {
+                std::memcpy(minRow, row, N);
+                candidateCount = 0;
+            }
+            if (rowCmp <= 0) {
+                candidates[candidateCount] = r;
+                candidateLabels[candidateCount] = next;
+                candidateCount++;
+            }
+        }
+
+        if (cmp == 0 && std::memcmp(minRow, best.data() + prefix, N) > 0) {
+            return;
+        }
+
+        for (int i = 0; i < candidateCount; ++i) {
+            std::memcpy(current.data() + prefix, minRow, N);
+            searchRows(depth + 1, usedRows | (1 << candidates[i]), candidates[i] / B,
+                       candidateLabels[i]);
+        }
+    }
+
+    // Column map from a stack order and an inner order per stack (indices into PERMS3)
+    void setColumns(int stacks, const int* inner) {
+        for (int s = 0; s < B; ++s) {
+            for (int i = 0; i < B; ++i) {
+                colMap[s * B + i] = PERMS3[stacks][s] * B + PERMS3[inner[s]][i];
+            }
+        }
+    }
+
+    // A column map that is part of the minimum must give some source row the
+    // smallest first row. Build the maps a stack at a time, keeping only the
+    // partial maps whose first row prefix is the smallest so far, the same
+    // pruning searchRows applies to rows. Then search rows under each map
+    // that is left.
+    void searchColumns() {
+        struct Partial {
+            uint8_t firstRow;
+            uint8_t stacks[B];
+            uint8_t inner[B];
+            Labels labels;
+        };
+
+        std::vector<Partial> partials;
+        std::vector<Partial> next;
+        for (int r = 0; r < N; ++r) {
+            partials.push_back({static_cast<uint8_t>(r), {}, {}, Labels()});
+        }
+
+        for (int s = 0; s < B; ++s) {
+            // Every partial shares the prefix so far, so only the new stack is compared
+            next.clear();
+            uint8_t minCells[B];
+            for (const Partial& partial : partials) {
+                for (int stack = 0; stack < B; ++stack) {
+                    bool used = false;
+                    for (int k = 0; k < s; ++k) {
+                        used |= partial.stacks[k] == stack;
+                    }
+                    if (used) continue;
+
+                    for (int p = 0; p < 6; ++p) {
+                        Partial extended = partial;
+                        extended.stacks[s] = static_cast<uint8_t>(stack);
+                        extended.inner[s] = static_cast<uint8_t>(p);
+                        uint8_t cells[B];
+                        for (int i = 0; i < B; ++i) {
+                            uint8_t v = source[partial.firstRow * N + stack * B + PERMS3[p][i]];
+                            if (v != 0) {
+                                if (extended.labels.map[v] == 0) {
+                                    extended.labels.map[v] = ++extended.labels.next;
+                                }
+                                v = extended.labels.map[v];
+                            }
+                            cells[i] = v;
+                        }
+
+                        int cellCmp = next.empty() ? -1 : std::memcmp(cells, minCells, B);
+                        if (cellCmp < 0) {
+                            std::memcpy(minCells, cells, B);
+                            next.clear();
+                        }
+                        if (cellCmp <= 0) {
+                            next.push_back(extended);
+                        }
+                    }
+                }
+            }
+            partials.swap(next);
+        }
+
+        // Several first rows can share a column map. Search each map once, in
+        // the order of the unpruned enumeration.
+        bool kept[6][6][6][6] = {};
+        for (const Partial& partial : partials) {
+            int stacks = 0;
+            while (PERMS3[stacks][0] != partial.stacks[0] || PERMS3[stacks][1] != partial.stacks[1]) {
+                stacks++;
+            }
+            kept[stacks][partial.inner[0]][partial.inner[1]][partial.inner[2]] = true;
+        }
+        for (int stacks = 0; stacks < 6; ++stacks) {
+            for (int i0 = 0; i0 < 6; ++i0) {
+                for (int i1 = 0; i1 < 6; ++i1) {
+                    for (int i2 = 0; i2 < 6; ++i2) {
+                        if (!kept[stacks][i0][i1][i2]) continue;
+                        const int inner[B] = {i0, i1, i2};
+                        setColumns(stacks, inner);
+                        searchRows(0, 0, 0, Labels());
+                    }
+                }
+            }
+        }
+    }
+};
+
+SudokuCanonicalizer::Grid SudokuCanonicalizer::canonicalGrid(const Board& board) {
+    Search search;
+    Grid grid = toGrid(board);
+
+    search.source = grid;
+    search.searchColumns();
+
+    for (int r = 0; r < N; ++r) {
+        for (int c = 0; c < N; ++c) {
+            search.source[r * N + c] = grid[c * N + r];
+        }
+    }
+    search.searchColumns();
+
+    return search.best;
+}
+
+std::string SudokuCanonicalizer::canonicalForm(const Board& board) {
+    Grid grid = canonicalGrid(board);
+    std::string text(grid.size(), '0');
+    for (size_t i = 0; i < grid.size(); ++i) {
+        text[i] = static_cast<char>('0' + grid[i]);
+    }
+    return text;
+}
+
+uint64_t SudokuCanonicalizer::canonicalHash(const Board& board) {
+    return hashGrid(canonicalGrid(board));
+}
+
+SudokuCanonicalizer::Grid SudokuCanonicalizer::toGrid(const Board& board) {
+    Grid grid;
+    for (int r = 0; r < N; ++r) {
+        for (int c = 0; c < N; ++c) {
+            grid[r * N + c] = static_cast<uint8_t>(board.getValue(r, c));
+        }
+    }
+    return grid;
+}
+
+uint64_t SudokuCanonicalizer::hashGrid(const Grid& grid) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint8_t v : grid) {
+        hash ^= v;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
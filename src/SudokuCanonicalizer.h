@@ -0,0 +1,27 @@
+//canonicalizer.h
+#pragma once
+
+#include "Board.h"
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Maps a board to the lexicographically minimal representative of its
+// equivalence class under transposition, band/row and stack/column
+// permutations and digit relabelling. Two puzzles that are the same
+// puzzle in disguise share a canonical form and hash.
+class SudokuCanonicalizer {
+public:
+    using Grid = std::array<uint8_t, Board::SIZE * Board::SIZE>;
+
+    static Grid canonicalGrid(const Board& board);
+    static std::string canonicalForm(const Board& board);
+    static uint64_t canonicalHash(const Board& board);
+    // 64-bit hash of a canonical grid; equal grids hash alike, the converse can fail
+    static uint64_t hashGrid(const Grid& grid);
+
+private:
+    struct Search;
+
+    static Grid toGrid(const Board& board);
+};
@@ -0,0 +1,513 @@
+//daemon.cpp
+#include "SudokuDaemon.h"
+#include "HintEngine.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr size_t GRID_BYTES = Board::SIZE * Board::SIZE;
+constexpr size_t HEADER_BYTES = 5; // op + id
+constexpr uint32_t MAX_FRAME_BYTES = 1 << 16;
+
+std::atomic<bool> signalled(false);
+
+void handleSignal(int) {
+    signalled = true;
+}
+
+uint32_t getU32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+           static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void putU64(std::vector<uint8_t>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+} // namespace
+
+#ifndef _WIN32
+
+struct SudokuDaemon::Connection {
+    int fd;
+    int wakeFd;
+    std::vector<uint8_t> readBuffer;
+    std::mutex writeMutex;
+    std::vector<uint8_t> writeBuffer;  // replies the socket has not taken yet
+    std::atomic<bool> broken;
+
+    Connection(int socketFd, int wakeWriteFd)
+        : fd(socketFd)
+        , wakeFd(wakeWriteFd)
+        , broken(false) {
+    }
+
+    // Workers may still hold a reference after the client hangs up, so the
+    // descriptor is only closed once nobody can write to it
+    ~Connection() {
+        close(fd);
+    }
+
+    // Called from pool workers; never blocks
+    void send(const std::vector<uint8_t>& body) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (broken) {
+            return;
+        }
+        bool idle = writeBuffer.empty();
+        putU32(writeBuffer, static_cast<uint32_t>(body.size()));
+        writeBuffer.insert(writeBuffer.end(), body.begin(), body.end());
+        if (writeBuffer.size() > MAX_QUEUED_BYTES) {
+            broken = true; // the client stopped reading
+            writeBuffer.clear();
+        } else if (idle) {
+            flushLocked();
+        }
+        // Anything left needs the poll loop to wait for POLLOUT
+        if (broken || !writeBuffer.empty()) {
+            char byte = 0;
+            ssize_t ignored = write(wakeFd, &byte, 1);
+            (void)ignored; // a full pipe already means a wake-up is pending
+        }
+    }
+
+    bool hasPendingWrites() {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        return !writeBuffer.empty();
+    }
+
+    void flush() {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        flushLocked();
+    }
+
+    void flushLocked() {
+        size_t written = 0;
+        while (written < writeBuffer.size()) {
+            ssize_t n = write(fd, writeBuffer.data() + written, writeBuffer.size() - written);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            if (n <= 0) {
+                broken = true; // client went away
+                writeBuffer.clear();
+                return;
+            }
+            written += static_cast<size_t>(n);
+        }
+        writeBuffer.erase(writeBuffer.begin(), writeBuffer.begin() + written);
+    }
+};
+
+SudokuDaemon::SudokuDaemon(const DaemonOptions& options)
+    : options_(options)
+    , stopping_(false) {
+}
+
+SudokuDaemon::~SudokuDaemon() {
+    stop();
+    if (refillThread_.joinable()) {
+        refillThread_.join();
+    }
+}
+
+void SudokuDaemon::stop() {
+    {
+        std::lock_guard<std::mutex> lock(inventoryMutex_);
+        stopping_ = true;
+    }
+    shutdown_.cancel();
+    inventoryChanged_.notify_all();
+}
+
+bool SudokuDaemon::run() {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (options_.socketPath.empty() || options_.socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Invalid socket path '" << options_.socketPath << "'" << std::endl;
+        return false;
+    }
+    std::strncpy(address.sun_path, options_.socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << "Could not create socket" << std::endl;
+        return false;
+    }
+    unlink(options_.socketPath.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listenFd, SOMAXCONN) < 0) {
+        std::cerr << "Could not listen on '" << options_.socketPath << "'" << std::endl;
+        close(listenFd);
+        return false;
+    }
+
+    int wake[2];
+    if (pipe(wake) < 0) {
+        std::cerr << "Could not create the wake-up pipe" << std::endl;
+        close(listenFd);
+        return false;
+    }
+    wakeRead_ = wake[0];
+    wakeWrite_ = wake[1];
+    fcntl(wakeRead_, F_SETFL, O_NONBLOCK);
+    fcntl(wakeWrite_, F_SETFL, O_NONBLOCK);
+
+    std::signal(SIGPIPE, SIG_IGN);
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    // Engine state is created once and shared by every request
+    pool_ = std::make_unique<ThreadPool>(options_.threads);
+    refillThread_ = std::thread(&SudokuDaemon::refillLoop, this);
+
+    std::cerr << "Serving on " << options_.socketPath << " with "
+              << pool_->getThreadCount() << " workers" << std::endl;
+    serveConnections(listenFd);
+
+    close(listenFd);
+    unlink(options_.socketPath.c_str());
+    stop();
+    refillThread_.join();
+    pool_.reset();
+    close(wakeRead_);
+    close(wakeWrite_);
+    return true;
+}
+
+void SudokuDaemon::serveConnections(int listenFd) {
+    std::vector<std::shared_ptr<Connection>> connections;
+    std::vector<pollfd> fds;
+    std::vector<Request> batch;
+    uint8_t chunk[1 << 14];
+
+    while (!stopping_ && !signalled) {
+        fds.clear();
+        fds.push_back({listenFd, POLLIN, 0});
+        fds.push_back({wakeRead_, POLLIN, 0});
+        for (const auto& connection : connections) {
+            // A client with replies still queued is not read from until it
+            // catches up, so it cannot pile up work for the pool
+            short events = connection->hasPendingWrites() ? POLLOUT : POLLIN;
+            fds.push_back({connection->fd, events, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), 100) <= 0) {
+            continue;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            while (read(wakeRead_, chunk, sizeof(chunk)) > 0) {
+            }
+        }
+
+        // Everything readable in this round is dispatched as one batch
+        std::vector<bool> closed(connections.size(), false);
+        for (size_t i = 0; i < connections.size(); ++i) {
+            Connection& connection = *connections[i];
+            short revents = fds[i + 2].revents;
+            if (revents & POLLOUT) {
+                connection.flush();
+            }
+            if (connection.broken) {
+                closed[i] = true;
+                continue;
+            }
+            if (!(revents & (POLLIN | POLLHUP | POLLERR))) continue;
+
+            ssize_t n = read(connection.fd, chunk, sizeof(chunk));
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) continue;
+            if (n <= 0) {
+                closed[i] = true;
+                continue;
+            }
+            auto& buffer = connection.readBuffer;
+            buffer.insert(buffer.end(), chunk, chunk + n);
+
+            size_t offset = 0;
+            while (buffer.size() - offset >= 4) {
+                uint32_t length = getU32(buffer.data() + offset);
+                if (length > MAX_FRAME_BYTES) {
+                    closed[i] = true;
+                    break;
+                }
+                if (buffer.size() - offset - 4 < length) break;
+                const uint8_t* body = buffer.data() + offset + 4;
+                batch.push_back({connections[i], std::vector<uint8_t>(body, body + length)});
+                offset += 4 + length;
+            }
+            buffer.erase(buffer.begin(), buffer.begin() + offset);
+        }
+
+        for (size_t i = connections.size(); i-- > 0;) {
+            if (closed[i]) {
+                connections.erase(connections.begin() + i);
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int clientFd = accept(listenFd, nullptr, nullptr);
+            if (clientFd >= 0) {
+                fcntl(clientFd, F_SETFL, fcntl(clientFd, F_GETFL) | O_NONBLOCK);
+                connections.push_back(std::make_shared<Connection>(clientFd, wakeWrite_));
+            }
+        }
+
+        dispatch(batch);
+        batch.clear();
+    }
+}
+
+void SudokuDaemon::dispatch(std::vector<Request>& batch) {
+    if (batch.empty()) {
+        return;
+    }
+
+    // One pool task per slice of the batch keeps task overhead off small requests
+    size_t slices = std::min(batch.size(), static_cast<size_t>(pool_->getThreadCount()));
+    size_t perSlice = (batch.size() + slices - 1) / slices;
+    for (size_t begin = 0; begin < batch.size(); begin += perSlice) {
+        size_t end = std::min(begin + perSlice, batch.size());
+        auto slice = std::make_shared<std::vector<Request>>(
+            std::make_move_iterator(batch.begin() + begin),
+            std::make_move_iterator(batch.begin() + end));
+        pool_->submit([this, slice]() {
+            for (const Request& request : *slice) {
+                if (request.connection->broken) continue;
+                request.connection->send(handle(request.body));
+            }
+        });
+    }
+}
+
+#else
+
+struct SudokuDaemon::Connection {
+};
+
+SudokuDaemon::SudokuDaemon(const DaemonOptions& options)
+    : options_(options)
+    , stopping_(false) {
+}
+
+SudokuDaemon::~SudokuDaemon() {
+}
+
+void SudokuDaemon::stop() {
+    stopping_ = true;
+}
+
+bool SudokuDaemon::run() {
+    std::cerr << "The daemon needs Unix domain sockets and is not available on Windows" << std::endl;
+    return false;
+}
+
+#endif
+
+std::vector<uint8_t> SudokuDaemon::handle(const std::vector<uint8_t>& body) {
+    std::vector<uint8_t> response;
+    if (body.size() < HEADER_BYTES) {
+        response.assign(HEADER_BYTES, 0);
+        response.push_back(static_cast<uint8_t>(Status::BAD_REQUEST));
+        return response;
+    }
+
+    Op op = static_cast<Op>(body[0]);
+    const uint8_t* payload = body.data() + HEADER_BYTES;
+    size_t payloadSize = body.size() - HEADER_BYTES;
+    response.assign(body.begin(), body.begin() + HEADER_BYTES);
+    response.push_back(static_cast<uint8_t>(Status::OK));
+    uint8_t& status = response.back();
+
+    Grid grid{};
+    if ((op == Op::SOLVE || op == Op::COUNT || op == Op::GRADE || op == Op::HINT) &&
+        payloadSize >= GRID_BYTES) {
+        std::copy(payload, payload + GRID_BYTES, grid.begin());
+    }
+
+    SearchLimits limits;
+    limits.token = &shutdown_;
+    limits.deadline = std::chrono::steady_clock::now() + options_.requestTimeout;
+    
+    auto solutionStatus = [](int solutions) {
+        if (solutions < 0) return Status::ABORTED;
+        if (solutions == 0) return Status::UNSOLVABLE;
+        if (solutions == 1) return Status::OK;
+        return Status::MULTIPLE_SOLUTIONS;
+    };
+
+    switch (op) {
+        case Op::SOLVE: {
+            if (payloadSize != GRID_BYTES) break;
+            Grid solution{};
+            status = static_cast<uint8_t>(solutionStatus(
+                BitboardSolver::countSolutions(grid, 2, &solution, &limits)));
+            if (status == static_cast<uint8_t>(Status::OK)) {
+                response.insert(response.end(), solution.begin(), solution.end());
+            }
+            return response;
+        }
+        case Op::COUNT: {
+            if (payloadSize != GRID_BYTES + 4) break;
+            uint32_t limit = std::min(getU32(payload + GRID_BYTES), MAX_COUNT_LIMIT);
+            EnumerationResult result = BitboardSolver::enumerate(grid, limit, nullptr, &limits);
+            if (result.aborted) {
+                status = static_cast<uint8_t>(Status::ABORTED);
+            }
+            putU64(response, result.solutions);
+            return response;
+        }
+        case Op::GENERATE: {
+            if (payloadSize != 6 || payload[0] >= DIFFICULTY_COUNT) break;
+            Difficulty difficulty = static_cast<Difficulty>(payload[0]);
+            StockedPuzzle stocked;
+            if (payload[1]) {
+                GeneratorOptions generatorOptions;
+                generatorOptions.seed = getU32(payload + 2);
+                stocked = makePuzzle(difficulty, generatorOptions, *limits.deadline);
+            } else {
+                stocked = takePuzzle(difficulty);
+            }
+            response.insert(response.end(), stocked.puzzle.begin(), stocked.puzzle.end());
+            response.insert(response.end(), stocked.solution.begin(), stocked.solution.end());
+            response.push_back(stocked.complete ? 1 : 0);
+            response.push_back(static_cast<uint8_t>(stocked.clueCount));
+            return response;
+        }
+        case Op::GRADE: {
+            if (payloadSize != GRID_BYTES) break;
+            uint64_t nodes = 0;
+            int solutions = BitboardSolver::countSolutions(grid, 2, nullptr, &limits, &nodes);
+            int clues = static_cast<int>(std::count_if(grid.begin(), grid.end(),
+                                                       [](uint8_t v) { return v != 0; }));
+            status = static_cast<uint8_t>(solutionStatus(solutions));
+            response.push_back(static_cast<uint8_t>(gradeByTechniques(grid)));
+            response.push_back(static_cast<uint8_t>(clues));
+            putU64(response, nodes);
+            return response;
+        }
+        case Op::HINT: {
+            if (payloadSize != GRID_BYTES) break;
+            Hint hint = HintEngine::findHint(grid);
+            response.push_back(static_cast<uint8_t>(hint.technique));
+            response.push_back(static_cast<uint8_t>(hint.cell < 0 ? 255 : hint.cell));
+            response.push_back(static_cast<uint8_t>(hint.value));
+            response.push_back(static_cast<uint8_t>(hint.unit < 0 ? 255 : hint.unit));
+            response.push_back(static_cast<uint8_t>(hint.eliminated));
+            return response;
+        }
+    }
+
+    response.resize(HEADER_BYTES + 1);
+    status = static_cast<uint8_t>(Status::BAD_REQUEST);
+    return response;
+}
+
+void SudokuDaemon::refillLoop() {
+    for (;;) {
+        Difficulty difficulty;
+        {
+            std::unique_lock<std::mutex> lock(inventoryMutex_);
+            auto lowest = [this]() {
+                return std::min_element(inventory_.begin(), inventory_.end(),
+                                        [](const auto& a, const auto& b) {
+                                            return a.size() < b.size();
+                                        });
+            };
+            inventoryChanged_.wait(lock, [&]() {
+                return stopping_ || lowest()->size() < options_.inventoryPerDifficulty;
+            });
+            if (stopping_) {
+                return;
+            }
+            difficulty = static_cast<Difficulty>(lowest() - inventory_.begin());
+        }
+
+        // Nobody waits on the refill, so Expert can afford a minimal puzzle search
+        GeneratorOptions generatorOptions;
+        generatorOptions.minimalSearch = difficulty == Difficulty::EXPERT;
+        StockedPuzzle stocked = makePuzzle(difficulty, generatorOptions,
+                                           std::chrono::steady_clock::now() + options_.expertSearchTime);
+        if (stopping_) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(inventoryMutex_);
+        inventory_[static_cast<int>(difficulty)].push_back(stocked);
+    }
+}
+
+SudokuDaemon::StockedPuzzle SudokuDaemon::takePuzzle(Difficulty difficulty) {
+    {
+        std::lock_guard<std::mutex> lock(inventoryMutex_);
+        auto& stock = inventory_[static_cast<int>(difficulty)];
+        if (!stock.empty()) {
+            StockedPuzzle stocked = stock.front();
+            stock.pop_front();
+            inventoryChanged_.notify_all();
+            return stocked;
+        }
+    }
+    inventoryChanged_.notify_all();
+    return makePuzzle(difficulty, GeneratorOptions(),
+                      std::chrono::steady_clock::now() + options_.requestTimeout);
+}
+
+Difficulty SudokuDaemon::gradeByTechniques(Grid grid) {
+    HintTechnique hardest = HintTechnique::NONE;
+    for (;;) {
+        Hint hint = HintEngine::findHint(grid);
+        if (hint.technique == HintTechnique::NONE) {
+            // Solved, or stuck on a board that needs search
+            if (std::find(grid.begin(), grid.end(), 0) != grid.end()) {
+                return Difficulty::EXPERT;
+            }
+            break;
+        }
+        if (hint.technique == HintTechnique::CONFLICT) {
+            return Difficulty::EXPERT;
+        }
+        hardest = std::max(hardest, hint.technique);
+        grid[hint.cell] = static_cast<uint8_t>(hint.value);
+    }
+    
+    if (hardest <= HintTechnique::HIDDEN_SINGLE) {
+        return Difficulty::EASY;
+    }
+    if (hardest == HintTechnique::NAKED_SINGLE) {
+        return Difficulty::MEDIUM;
+    }
+    return Difficulty::HARD;
+}
+
+SudokuDaemon::StockedPuzzle SudokuDaemon::makePuzzle(Difficulty difficulty,
+                                                     const GeneratorOptions& options,
+                                                     std::chrono::steady_clock::time_point deadline) {
+    StockedPuzzle stocked;
+    GenerationResult generated = SudokuGenerator::generate(difficulty, options, deadline, shutdown_);
+    stocked.puzzle = BitboardSolver::fromBoard(generated.puzzle);
+    stocked.solution = BitboardSolver::fromBoard(generated.solution);
+    stocked.complete = generated.complete;
+    stocked.clueCount = generated.clueCount;
+    return stocked;
+}
@@ -0,0 +1,130 @@
+//daemon.h
+#pragma once
+
+#include "BitboardSolver.h"
+#include "SudokuGenerator.h"
+#include "ThreadPool.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct DaemonOptions {
+    std::string socketPath;
+    int threads = 0;                  // worker pool size, 0 = all cores
+    size_t inventoryPerDifficulty = 16;
+    // SOLVE, COUNT and GRADE give up after this long and answer ABORTED,
+    // and a GENERATE the inventory cannot serve returns its best puzzle so
+    // far, so no request holds a worker for long
+    std::chrono::milliseconds requestTimeout{100};
+    // Expert puzzles for the inventory run MinimalPuzzleSearch this long
+    std::chrono::milliseconds expertSearchTime{1000};
+};
+
+// Local solve/generate service on a Unix domain socket, so consumers skip
+// the engine's cold start. Frames are a little-endian u32 body length
+// followed by the body. Requests are {u8 op, u32 id, payload}; responses
+// are {u8 op, u32 id, u8 status, payload}. Grids are 81 bytes, 0 = empty.
+//
+//   SOLVE    grid                  -> solution grid when status is OK
+//   COUNT    grid, u32 limit       -> u64 solutions (capped at limit and at
+//                                     MAX_COUNT_LIMIT; so far when ABORTED)
+//   GENERATE u8 difficulty,
+//            u8 seeded, u32 seed   -> puzzle grid, solution grid, u8 complete,
+//                                     u8 clues (complete is 0 when
+//                                     requestTimeout cut clue removal short)
+//   GRADE    grid                  -> u8 difficulty, u8 clues, u64 search nodes
+//                                     (difficulty from the hardest HintEngine
+//                                     technique a logical solve needs, EXPERT
+//                                     if it needs search; status as SOLVE)
+//   HINT     grid                  -> u8 technique, u8 cell, u8 value, u8 unit,
+//                                     u8 eliminated digit (HintEngine; cell and
+//                                     unit are 255 when absent)
+//
+// Requests that arrive together are batched onto the worker pool, and
+// unseeded GENERATE requests are served from a per-difficulty inventory
+// that a background thread keeps stocked. Replies never block a worker:
+// what the socket does not take at once is queued and flushed by the poll
+// loop, and a client that lets MAX_QUEUED_BYTES pile up is disconnected.
+class SudokuDaemon {
+public:
+    enum class Op : uint8_t {
+        SOLVE = 1,
+        COUNT = 2,
+        GENERATE = 3,
+        GRADE = 4,
+        HINT = 5
+    };
+
+    enum class Status : uint8_t {
+        OK = 0,
+        UNSOLVABLE = 1,
+        MULTIPLE_SOLUTIONS = 2,
+        ABORTED = 3,      // requestTimeout ran out or the daemon is stopping
+        BAD_REQUEST = 255
+    };
+    
+    static constexpr uint32_t MAX_COUNT_LIMIT = 1000000;
+    static constexpr size_t MAX_QUEUED_BYTES = 1 << 20;
+
+    explicit SudokuDaemon(const DaemonOptions& options);
+    ~SudokuDaemon();
+
+    // Blocks until stop() or SIGINT/SIGTERM; false if the socket could not be opened
+    bool run();
+    void stop();
+
+private:
+    using Grid = BitboardSolver::Grid;
+
+    struct Connection;
+
+    struct Request {
+        std::shared_ptr<Connection> connection;
+        std::vector<uint8_t> body;
+    };
+
+    struct StockedPuzzle {
+        Grid puzzle;
+        Grid solution;
+        bool complete;
+        int clueCount;
+    };
+
+    static constexpr int DIFFICULTY_COUNT = 4;
+
+    DaemonOptions options_;
+    std::atomic<bool> stopping_;
+    // Raised by stop() so searches still running end early
+    CancellationToken shutdown_;
+    std::unique_ptr<ThreadPool> pool_;
+
+    std::mutex inventoryMutex_;
+    std::condition_variable inventoryChanged_;
+    std::array<std::deque<StockedPuzzle>, DIFFICULTY_COUNT> inventory_;
+    std::thread refillThread_;
+    
+    // Workers write a byte here so the poll loop picks up queued replies
+    int wakeRead_ = -1;
+    int wakeWrite_ = -1;
+
+    void serveConnections(int listenFd);
+    void dispatch(std::vector<Request>& batch);
+    std::vector<uint8_t> handle(const std::vector<uint8_t>& body);
+
+    void refillLoop();
+    StockedPuzzle takePuzzle(Difficulty difficulty);
+    // Places hint after hint: singles alone are EASY or MEDIUM, eliminations
+    // HARD, and a board the ladder gets stuck on needs search, so EXPERT
+    static Difficulty gradeByTechniques(Grid grid);
+    // Stops at the deadline or on shutdown with the best puzzle so far
+    StockedPuzzle makePuzzle(Difficulty difficulty, const GeneratorOptions& options,
+                             std::chrono::steady_clock::time_point deadline);
+};
@@ -1,21 +1,150 @@
 //generator_cpp
 #include "SudokuGenerator.h"
+#include "GenerationTelemetry.h"
+#include "GridSampler.h"
+#include "MinimalPuzzleSearch.h"
+#include "ThreadPool.h"
 #include <algorithm>
+#include <future>
+#include <memory>
 #include <random>
 #include <vector>
 
-Board SudokuGenerator::generate(Difficulty difficulty) {
-    Board board = generateFullBoard();
-    return removeCells(board, difficulty);
+GenerationResult SudokuGenerator::generate(Difficulty difficulty) {
+    return generate(difficulty, GeneratorOptions());
 }
 
-Board SudokuGenerator::generateFullBoard() {
-    Board board;
-    SudokuSolver::solve(board);
-    return board;
+GenerationResult SudokuGenerator::generate(Difficulty difficulty, const GeneratorOptions& options) {
+    return generate(difficulty, options, nullptr);
 }
 
-Board SudokuGenerator::removeCells(Board board, Difficulty difficulty) {
+GenerationResult SudokuGenerator::generate(Difficulty difficulty, const GeneratorOptions& options,
+                                           std::chrono::steady_clock::time_point deadline,
+                                           const CancellationToken& token) {
+    SearchLimits limits;
+    limits.token = &token;
+    limits.deadline = deadline;
+    return generate(difficulty, options, &limits);
+}
+
+GenerationResult SudokuGenerator::generate(Difficulty difficulty, const GeneratorOptions& options,
+                                           const SearchLimits* limits) {
+    auto start = std::chrono::steady_clock::now();
+    uint32_t seed = options.seed ? *options.seed : std::random_device()();
+    std::mt19937 g(seed);
+    
+    // Sampling a full grid takes about 12us and is not interrupted, so
+    // even an expired deadline returns the full grid as a valid puzzle
+    GenerationResult result;
+    result.seed = seed;
+    result.solution = generateFullBoard(g, options.gridPool);
+    result.puzzle = result.solution;
+    result.stats.fullBoardTime = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    result.targetClues = getClueCount(difficulty);
+    
+    if (difficulty == Difficulty::EXPERT && options.minimalSearch && limits && limits->deadline &&
+        options.symmetry == Symmetry::NONE) {
+        MinimalSearchOptions searchOptions;
+        searchOptions.targetClues = result.targetClues;
+        searchOptions.threads = options.threads;
+        searchOptions.seed = g();
+        
+        MinimalSearchResult search = MinimalPuzzleSearch::search(searchOptions, *limits);
+        bool useSearch = search.minimal;
+        if (!search.minimal) {
+            // The limits ran out before the search finished a single pass. A
+            // greedy pass takes about a millisecond, so it runs to the end
+            // rather than hand back the solved grid, and the puzzle with
+            // fewer clues is kept.
+            removeCells(result.puzzle, difficulty, options.symmetry, g,
+                        ThreadPool::resolveThreadCount(options.threads), nullptr, result.stats);
+            useSearch = search.found && search.clueCount < countClues(result.puzzle);
+        }
+        if (useSearch) {
+            result.puzzle = search.puzzle;
+            result.solution = search.solution;
+        }
+        result.complete = search.reachedTarget;
+    } else {
+        result.complete = removeCells(result.puzzle, difficulty, options.symmetry, g,
+                                      ThreadPool::resolveThreadCount(options.threads), limits,
+                                      result.stats);
+    }
+    
+    result.clueCount = countClues(result.puzzle);
+    result.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    
+    if (options.telemetry) {
+        options.telemetry->record(difficulty, result);
+    }
+    return result;
+}
+
+int SudokuGenerator::countClues(const Board& board) {
+    int clues = 0;
+    for (int r = 0; r < Board::SIZE; ++r) {
+        for (int c = 0; c < Board::SIZE; ++c) {
+            if (!board.getCell(r, c).isEmpty()) {
+                clues++;
+            }
+        }
+    }
+    return clues;
+}
+
+Board SudokuGenerator::generateFullBoard(std::mt19937& rng, const GridPool* pool) {
+    return BitboardSolver::toBoard(pool ? pool->draw(rng) : GridSampler::sample(rng));
+}
+
+std::vector<std::vector<std::pair<int, int>>> SudokuGenerator::getOrbits(Symmetry symmetry) {
+    const int last = Board::SIZE - 1;
+    std::vector<std::vector<std::pair<int, int>>> orbits;
+    bool seen[Board::SIZE][Board::SIZE] = {};
+    
+    for (int r = 0; r < Board::SIZE; ++r) {
+        for (int c = 0; c < Board::SIZE; ++c) {
+            if (seen[r][c]) continue;
+            
+            std::pair<int, int> images[4] = {{r, c}, {r, c}, {r, c}, {r, c}};
+            switch (symmetry) {
+                case Symmetry::ROTATE_180:
+                    images[1] = {last - r, last - c};
+                    break;
+                case Symmetry::ROTATE_90:
+                    images[1] = {c, last - r};
+                    images[2] = {last - r, last - c};
+                    images[3] = {last - c, r};
+                    break;
+                case Symmetry::MIRROR:
+                    images[1] = {r, last - c};
+                    break;
+                case Symmetry::MIRROR_BOTH:
+                    images[1] = {r, last - c};
+                    images[2] = {last - r, c};
+                    images[3] = {last - r, last - c};
+                    break;
+                default:
+                    break;
+            }
+            
+            std::vector<std::pair<int, int>> orbit;
+            for (const auto& image : images) {
+                if (!seen[image.first][image.second]) {
+                    seen[image.first][image.second] = true;
+                    orbit.push_back(image);
+                }
+            }
+            orbits.push_back(std::move(orbit));
+        }
+    }
+    return orbits;
+}
+
+bool SudokuGenerator::removeCells(Board& board, Difficulty difficulty, Symmetry symmetry,
+                                  std::mt19937& rng, int threads, const SearchLimits* limits,
+                                  GenerationStats& stats) {
     // Mark all cells as given initially
     for (int r = 0; r < Board::SIZE; ++r) {
         for (int c = 0; c < Board::SIZE; ++c) {
@@ -26,43 +155,110 @@ Board SudokuGenerator::removeCells(Board board, Difficulty difficulty) {
     int targetClues = getClueCount(difficulty);
     int cellsToRemove = Board::SIZE * Board::SIZE - targetClues;
     
-    // Create list of all positions
-    std::vector<std::pair<int, int>> positions;
-    for (int r = 0; r < Board::SIZE; ++r) {
-        for (int c = 0; c < Board::SIZE; ++c) {
-            positions.emplace_back(r, c);
-        }
+    // Each orbit is removed whole with a single uniqueness check, so the
+    // clue pattern stays symmetric. Without symmetry every orbit is one cell.
+    std::vector<std::vector<std::pair<int, int>>> positions = getOrbits(symmetry);
+    std::shuffle(positions.begin(), positions.end(), rng);
+    if (symmetry != Symmetry::NONE) {
+        // Cells the symmetry maps to themselves are orbits of one: the centre,
+        // and under MIRROR the whole middle column. They alone can close an
+        // odd gap, so they are kept back until the larger orbits are tried.
+        std::stable_partition(positions.begin(), positions.end(),
+                              [](const std::vector<std::pair<int, int>>& orbit) {
+                                  return orbit.size() > 1;
+                              });
     }
     
-    // Shuffle positions
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(positions.begin(), positions.end(), g);
+    // Neighbouring trials revisit many of the same subtrees. Each
+    // speculative slot gets its own table since tables are not thread-safe.
+    std::vector<TranspositionTable> tables(threads);
+    std::unique_ptr<ThreadPool> pool;
+    if (threads > 1) {
+        pool = std::make_unique<ThreadPool>(threads);
+    }
     
-    // Try to remove cells while maintaining unique solution
+    auto tryRemoval = [&board, &tables, limits](size_t slot,
+                                                const std::vector<std::pair<int, int>>& orbit) {
+        Board trial = board;
+        for (const auto& pos : orbit) {
+            trial.setValue(pos.first, pos.second, 0);
+        }
+        return SudokuSolver::countSolutions(trial, 2, &tables[slot], limits);
+    };
+    
+    // Test the next batch of removals against the current board, then commit
+    // them in shuffled order. A rejection stays valid after other cells are
+    // removed (fewer clues never restore uniqueness), but an acceptance that
+    // follows a commit in the same batch was tested against a stale board
+    // and is retried in the next batch. This matches the sequential result.
     int removed = 0;
-    for (const auto& pos : positions) {
-        if (removed >= cellsToRemove) break;
+    size_t next = 0;
+    std::vector<SudokuSolver::Result> results(threads);
+    
+    while (removed < cellsToRemove && next < positions.size()) {
+        if (limits && limits->shouldStop()) {
+            return false;
+        }
         
-        int row = pos.first;
-        int col = pos.second;
-        int value = board.getValue(row, col);
+        // Removals only grow, so an orbit too big for the gap now never fits;
+        // drop it before it costs a uniqueness check
+        positions.erase(std::remove_if(positions.begin() + next, positions.end(),
+                                       [removed, cellsToRemove](const std::vector<std::pair<int, int>>& orbit) {
+                                           return removed + static_cast<int>(orbit.size()) > cellsToRemove;
+                                       }),
+                        positions.end());
+        if (next == positions.size()) {
+            break;
+        }
         
-        // Temporarily remove the cell
-        board.setValue(row, col, 0);
-        board.getCell(row, col).setGiven(false);
+        size_t batch = std::min(static_cast<size_t>(threads), positions.size() - next);
+        auto checkStart = std::chrono::steady_clock::now();
         
-        // Check if solution is still unique
-        if (SudokuSolver::hasUniqueSolution(board)) {
-            removed++;
+        if (pool) {
+            std::vector<std::future<SudokuSolver::Result>> trials;
+            for (size_t k = 0; k < batch; ++k) {
+                trials.push_back(pool->submit([&tryRemoval, &positions, next, k]() {
+                    return tryRemoval(k, positions[next + k]);
+                }));
+            }
+            for (size_t k = 0; k < batch; ++k) {
+                results[k] = trials[k].get();
+            }
         } else {
-            // Restore the cell if removal breaks uniqueness
-            board.setValue(row, col, value);
-            board.getCell(row, col).setGiven(true);
+            results[0] = tryRemoval(0, positions[next]);
+        }
+        stats.uniquenessChecks += static_cast<int>(batch);
+        stats.uniquenessTime += std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - checkStart);
+        
+        bool committed = false;
+        size_t consumed = 0;
+        for (size_t k = 0; k < batch && removed < cellsToRemove; ++k) {
+            if (results[k] == SudokuSolver::Result::ABORTED) {
+                return false; // Commits made before this trial stand
+            }
+            // An earlier commit in this batch can leave an orbit too big to fit
+            const auto& orbit = positions[next + k];
+            bool fits = removed + static_cast<int>(orbit.size()) <= cellsToRemove;
+            if (fits && results[k] == SudokuSolver::Result::SOLVED) {
+                if (committed) break;
+                
+                for (const auto& pos : orbit) {
+                    board.setValue(pos.first, pos.second, 0);
+                    board.getCell(pos.first, pos.second).setGiven(false);
+                }
+                removed += static_cast<int>(orbit.size());
+                stats.acceptedRemovals++;
+                committed = true;
+            } else if (fits) {
+                stats.rejectedRemovals++;
+            }
+            consumed++;
         }
+        next += consumed;
     }
     
-    return board;
+    return true;
 }
 
 int SudokuGenerator::getClueCount(Difficulty difficulty) {
@@ -80,3 +276,34 @@ int SudokuGenerator::getClueCount(Difficulty difficulty) {
     }
 }
 
+const char* SudokuGenerator::getDifficultyName(Difficulty difficulty) {
+    switch (difficulty) {
+        case Difficulty::EASY:
+            return "easy";
+        case Difficulty::MEDIUM:
+            return "medium";
+        case Difficulty::HARD:
+            return "hard";
+        case Difficulty::EXPERT:
+            return "expert";
+        default:
+            return "unknown";
+    }
+}
+
+const char* SudokuGenerator::getSymmetryName(Symmetry symmetry) {
+    switch (symmetry) {
+        case Symmetry::NONE:
+            return "none";
+        case Symmetry::ROTATE_180:
+            return "rotate180";
+        case Symmetry::ROTATE_90:
+            return "rotate90";
+        case Symmetry::MIRROR:
+            return "mirror";
+        case Symmetry::MIRROR_BOTH:
+            return "mirror-both";
+        default:
+            return "unknown";
+    }
+}
@@ -3,7 +3,16 @@
 
 #include "Board.h"
 #include "SudokuSolver.h"
+#include "CancellationToken.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
 #include <random>
+#include <utility>
+#include <vector>
+
+class GenerationTelemetry;
+class GridPool;
 
 enum class Difficulty {
     EASY = 0,
@@ -12,13 +21,79 @@ enum class Difficulty {
     EXPERT = 3
 };
 
+// Clue patterns the generator can keep. Cells are removed in orbits of
+// the symmetry group, so every puzzle has the pattern, not just most.
+enum class Symmetry {
+    NONE = 0,
+    ROTATE_180 = 1,     // orbits of 2 (the centre on its own)
+    ROTATE_90 = 2,      // orbits of 4 (the centre on its own)
+    MIRROR = 3,         // left-right mirror, orbits of 2 (middle column cells on their own)
+    MIRROR_BOTH = 4     // both axes, orbits of 4 (2 on the middle lines, the centre alone)
+};
+
+struct GeneratorOptions {
+    // Same seed, same puzzle; unset draws one from std::random_device
+    std::optional<uint32_t> seed;
+    // Removal trials run speculatively on this many threads (0 = all cores).
+    // The result does not depend on the thread count.
+    int threads = 1;
+    // EXPERT with a deadline only: run MinimalPuzzleSearch until the
+    // deadline instead of a single greedy removal pass
+    bool minimalSearch = false;
+    // Symmetric clue patterns override minimalSearch, whose puzzles are not
+    Symmetry symmetry = Symmetry::NONE;
+    // Every generate call is recorded here when set
+    GenerationTelemetry* telemetry = nullptr;
+    // Solution grids are drawn from this pool when set, instead of being
+    // sampled fresh; see GridPool for what that does to variety
+    const GridPool* gridPool = nullptr;
+};
+
+struct GenerationStats {
+    std::chrono::microseconds fullBoardTime{0};
+    std::chrono::microseconds uniquenessTime{0};  // wall time spent waiting on checks
+    int uniquenessChecks = 0;                    // including discarded speculative trials
+    int acceptedRemovals = 0;
+    int rejectedRemovals = 0;
+};
+
+// Everything a generate call knows about its puzzle, so consumers and
+// banks never solve it again to get the solution back
+struct GenerationResult {
+    Board puzzle;       // always has a unique solution
+    Board solution;     // the grid the clues were taken from
+    uint32_t seed;      // options.seed, or the one drawn when it was unset
+    int clueCount;
+    int targetClues;
+    bool complete;      // false if the deadline or cancellation cut removal short
+    std::chrono::microseconds elapsed;
+    GenerationStats stats;
+};
+
 class SudokuGenerator {
 public:
-    static Board generate(Difficulty difficulty);
+    static GenerationResult generate(Difficulty difficulty);
+    static GenerationResult generate(Difficulty difficulty, const GeneratorOptions& options);
+    // Stops at the deadline or on cancellation and returns the puzzle with
+    // the fewest clues reached so far
+    static GenerationResult generate(Difficulty difficulty, const GeneratorOptions& options,
+                                     std::chrono::steady_clock::time_point deadline,
+                                     const CancellationToken& token);
     
-private:
-    static Board generateFullBoard();
-    static Board removeCells(Board board, Difficulty difficulty);
     static int getClueCount(Difficulty difficulty);
+    // Lowercase name used on the command line and in exported metrics
+    static const char* getDifficultyName(Difficulty difficulty);
+    static const char* getSymmetryName(Symmetry symmetry);
+    
+private:
+    static GenerationResult generate(Difficulty difficulty, const GeneratorOptions& options,
+                                     const SearchLimits* limits);
+    static int countClues(const Board& board);
+    static Board generateFullBoard(std::mt19937& rng, const GridPool* pool);
+    // Cells grouped into the orbits of the symmetry, in row-major order of their first cell
+    static std::vector<std::vector<std::pair<int, int>>> getOrbits(Symmetry symmetry);
+    // Returns false if the limits stopped removal early
+    static bool removeCells(Board& board, Difficulty difficulty, Symmetry symmetry,
+                            std::mt19937& rng, int threads, const SearchLimits* limits,
+                            GenerationStats& stats);
 };
-
@@ -1,22 +1,55 @@
 // solver.cpp
 #include "SudokuSolver.h"
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <random>
 
-SudokuSolver::Result SudokuSolver::solve(Board& board) {
+SudokuSolver::Result SudokuSolver::solve(Board& board, const SearchLimits* limits) {
+    std::random_device rd;
+    std::mt19937 g(rd());
+    return solve(board, g, limits);
+}
+
+SudokuSolver::Result SudokuSolver::solve(Board& board, std::mt19937& rng,
+                                         const SearchLimits* limits) {
+    if (hasConflicts(board)) {
+        return Result::UNSOLVABLE;
+    }
+    SearchContext context{0, 1, nullptr, limits, 0, false, nullptr};
     Board copy = board;
-    if (solveRecursive(copy)) {
+    if (solveRecursive(copy, rng, context)) {
         board = copy;
         return Result::SOLVED;
     }
-    return Result::UNSOLVABLE;
+    return context.aborted ? Result::ABORTED : Result::UNSOLVABLE;
 }
 
-SudokuSolver::Result SudokuSolver::countSolutions(const Board& board, int maxSolutions) {
-    int count = 0;
+SudokuSolver::Result SudokuSolver::countSolutions(const Board& board, int maxSolutions,
+                                                  TranspositionTable* table,
+                                                  const SearchLimits* limits, uint64_t* nodes) {
+    if (nodes) {
+        *nodes = 0;
+    }
+    if (hasConflicts(board)) {
+        return Result::UNSOLVABLE;
+    }
+    SearchContext context{0, maxSolutions, table, limits, 0, false, nullptr};
     Board copy = board;
-    countSolutionsRecursive(copy, count, maxSolutions);
+    countSolutionsRecursive(copy, context);
+    if (nodes) {
+        *nodes = context.nodes;
+    }
     
+    return context.aborted ? Result::ABORTED : toResult(context.count);
+}
+
+bool SudokuSolver::hasUniqueSolution(const Board& board, TranspositionTable* table) {
+    return countSolutions(board, 2, table) == Result::SOLVED;
+}
+
+SudokuSolver::Result SudokuSolver::toResult(int count) {
     if (count == 0) {
         return Result::UNSOLVABLE;
     } else if (count == 1) {
@@ -26,11 +59,153 @@ SudokuSolver::Result SudokuSolver::countSolutions(const Board& board, int maxSol
     }
 }
 
-bool SudokuSolver::hasUniqueSolution(const Board& board) {
-    return countSolutions(board, 2) == Result::SOLVED;
+struct SudokuSolver::ParallelSearch {
+    ThreadPool& pool;
+    int maxSolutions;
+    const SearchLimits* callerLimits;
+    
+    // Raised once maxSolutions are found; the caller's limits are the parent
+    CancellationToken stopToken;
+    SearchLimits limits;
+    
+    std::atomic<int> count{0};
+    std::atomic<bool> aborted{false};
+    
+    std::mutex mutex;
+    std::condition_variable finished;
+    int pendingTasks = 0;
+    bool wantSolution = false;
+    bool haveSolution = false;
+    Board solution;
+    
+    ParallelSearch(ThreadPool& threadPool, int max, const SearchLimits* caller)
+        : pool(threadPool)
+        , maxSolutions(max)
+        , callerLimits(caller) {
+        limits.token = &stopToken;
+        limits.parent = caller;
+    }
+    
+    void spawn(Board board, int depth) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pendingTasks++;
+        }
+        pool.submit([this, board, depth]() mutable {
+            run(board, depth);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pendingTasks == 0) {
+                finished.notify_all();
+            }
+        });
+    }
+    
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]() { return pendingTasks == 0; });
+    }
+    
+    void addSolutions(int found, const Board* board) {
+        if (found <= 0) return;
+        if (board && wantSolution) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!haveSolution) {
+                solution = *board;
+                haveSolution = true;
+            }
+        }
+        if (count.fetch_add(found) + found >= maxSolutions) {
+            stopToken.cancel();
+        }
+    }
+    
+    void run(Board& board, int depth) {
+        if (stopToken.isCancelled()) {
+            return;
+        }
+        if (callerLimits && callerLimits->shouldStop()) {
+            aborted = true;
+            return;
+        }
+        
+        if (depth < PARALLEL_SPLIT_DEPTH) {
+            auto empty = findEmptyCell(board);
+            if (empty.first == -1) {
+                addSolutions(1, &board);
+                return;
+            }
+            for (int num = 1; num <= 9; ++num) {
+                if (board.isValidPlacement(empty.first, empty.second, num)) {
+                    Board child = board;
+                    child.setValue(empty.first, empty.second, num);
+                    spawn(child, depth + 1);
+                }
+            }
+            return;
+        }
+        
+        Board found;
+        SearchContext context{0, maxSolutions - count.load(), nullptr, &limits, 0, false,
+                              wantSolution ? &found : nullptr};
+        if (context.maxSolutions <= 0) {
+            return;
+        }
+        countSolutionsRecursive(board, context);
+        addSolutions(context.count, wantSolution ? &found : nullptr);
+        if (context.aborted && !stopToken.isCancelled()) {
+            aborted = true;
+        }
+    }
+};
+
+SudokuSolver::Result SudokuSolver::solve(Board& board, ThreadPool& pool,
+                                         const SearchLimits* limits) {
+    Board solution;
+    Result result = searchParallel(board, 1, pool, limits, &solution);
+    if (result == Result::SOLVED) {
+        board = solution;
+    }
+    return result;
+}
+
+SudokuSolver::Result SudokuSolver::countSolutions(const Board& board, int maxSolutions,
+                                                  ThreadPool& pool, const SearchLimits* limits) {
+    return searchParallel(board, maxSolutions, pool, limits, nullptr);
+}
+
+SudokuSolver::Result SudokuSolver::searchParallel(const Board& board, int maxSolutions,
+                                                  ThreadPool& pool, const SearchLimits* limits,
+                                                  Board* firstSolution) {
+    if (hasConflicts(board)) {
+        return Result::UNSOLVABLE;
+    }
+    ParallelSearch search(pool, maxSolutions, limits);
+    search.wantSolution = firstSolution != nullptr;
+    search.spawn(board, 0);
+    search.wait();
+    
+    int count = std::min(search.count.load(), maxSolutions);
+    if (count < maxSolutions && search.aborted) {
+        return Result::ABORTED;
+    }
+    if (firstSolution && search.haveSolution) {
+        *firstSolution = search.solution;
+    }
+    return toResult(count);
+}
+
+bool SudokuSolver::SearchContext::checkLimits() {
+    if (++nodes % NODES_PER_LIMIT_CHECK == 0 && !aborted && limits && limits->shouldStop()) {
+        aborted = true;
+    }
+    return aborted;
 }
 
-bool SudokuSolver::solveRecursive(Board& board) {
+bool SudokuSolver::solveRecursive(Board& board, std::mt19937& rng, SearchContext& context) {
+    if (context.checkLimits()) {
+        return false;
+    }
+    
     auto empty = findEmptyCell(board);
     if (empty.first == -1) {
         return true; // Board is complete
@@ -39,45 +214,74 @@ bool SudokuSolver::solveRecursive(Board& board) {
     int row = empty.first;
     int col = empty.second;
     
-    auto numbers = getShuffledNumbers();
+    auto numbers = getShuffledNumbers(rng);
     for (int num : numbers) {
         if (board.isValidPlacement(row, col, num)) {
             board.setValue(row, col, num);
-            if (solveRecursive(board)) {
+            if (solveRecursive(board, rng, context)) {
                 return true;
             }
             board.setValue(row, col, 0);
+            if (context.aborted) {
+                return false;
+            }
         }
     }
     
     return false;
 }
 
-int SudokuSolver::countSolutionsRecursive(Board board, int& count, int maxSolutions) {
-    if (count >= maxSolutions) {
-        return count;
+void SudokuSolver::countSolutionsRecursive(Board& board, SearchContext& context) {
+    if (context.count >= context.maxSolutions || context.checkLimits()) {
+        return;
     }
     
     auto empty = findEmptyCell(board);
     if (empty.first == -1) {
-        count++;
-        return count;
+        if (context.count == 0 && context.firstSolution) {
+            *context.firstSolution = board;
+        }
+        context.count++;
+        return;
+    }
+    
+    uint64_t hash = board.getHash();
+    int known = 0;
+    if (context.table && context.table->lookup(hash, known)) {
+        context.count += known;
+        return;
     }
     
     int row = empty.first;
     int col = empty.second;
+    int countBefore = context.count;
     
     for (int num = 1; num <= 9; ++num) {
         if (board.isValidPlacement(row, col, num)) {
             board.setValue(row, col, num);
-            countSolutionsRecursive(board, count, maxSolutions);
-            if (count >= maxSolutions) {
-                return count;
+            countSolutionsRecursive(board, context);
+            board.setValue(row, col, 0);
+            if (context.count >= context.maxSolutions || context.aborted) {
+                return; // Subtree not fully explored, nothing to cache
             }
         }
     }
     
-    return count;
+    if (context.table) {
+        context.table->store(hash, context.count - countBefore);
+    }
+}
+
+bool SudokuSolver::hasConflicts(const Board& board) {
+    for (int r = 0; r < Board::SIZE; ++r) {
+        for (int c = 0; c < Board::SIZE; ++c) {
+            int value = board.getValue(r, c);
+            if (value != 0 && !board.isValidPlacement(r, c, value)) {
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
 std::pair<int, int> SudokuSolver::findEmptyCell(const Board& board) {
@@ -91,11 +295,9 @@ std::pair<int, int> SudokuSolver::findEmptyCell(const Board& board) {
     return {-1, -1};
 }
 
-std::vector<int> SudokuSolver::getShuffledNumbers() {
+std::vector<int> SudokuSolver::getShuffledNumbers(std::mt19937& rng) {
     std::vector<int> numbers = {1, 2, 3, 4, 5, 6, 7, 8, 9};
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(numbers.begin(), numbers.end(), g);
+    std::shuffle(numbers.begin(), numbers.end(), rng);
     return numbers;
 }
 
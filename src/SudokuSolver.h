@@ -2,6 +2,10 @@
 #pragma once
 
 #include "Board.h"
+#include "CancellationToken.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+#include <cstdint>
 #include <vector>
 #include <random>
 
@@ -10,17 +14,58 @@ public:
     enum class Result {
         SOLVED,
         UNSOLVABLE,
-        MULTIPLE_SOLUTIONS
+        MULTIPLE_SOLUTIONS,
+        ABORTED // search limits were hit before an answer was known
     };
     
-    static Result solve(Board& board);
-    static Result countSolutions(const Board& board, int maxSolutions = 2);
-    static bool hasUniqueSolution(const Board& board);
+    // Searches poll the optional limits every NODES_PER_LIMIT_CHECK nodes
+    static constexpr uint64_t NODES_PER_LIMIT_CHECK = SearchLimits::NODES_PER_CHECK;
+    
+    static Result solve(Board& board, const SearchLimits* limits = nullptr);
+    // Fills empty cells trying digits in an order drawn from rng
+    static Result solve(Board& board, std::mt19937& rng, const SearchLimits* limits = nullptr);
+    // An optional table lets repeated searches skip subtrees already proved
+    // unsolvable or unique.
+    // nodes, when given, is set to the number of search nodes visited.
+    static Result countSolutions(const Board& board, int maxSolutions = 2,
+                                 TranspositionTable* table = nullptr,
+                                 const SearchLimits* limits = nullptr,
+                                 uint64_t* nodes = nullptr);
+    static bool hasUniqueSolution(const Board& board, TranspositionTable* table = nullptr);
+    
+    // Parallel mode: the tree is split into one task per branch down to
+    // PARALLEL_SPLIT_DEPTH and the tasks run on the pool, stopping globally
+    // once maxSolutions are found. Must not be called from a pool task.
+    static constexpr int PARALLEL_SPLIT_DEPTH = 3;
+    
+    static Result solve(Board& board, ThreadPool& pool, const SearchLimits* limits = nullptr);
+    static Result countSolutions(const Board& board, int maxSolutions, ThreadPool& pool,
+                                 const SearchLimits* limits = nullptr);
     
 private:
-    static bool solveRecursive(Board& board);
-    static int countSolutionsRecursive(Board board, int& count, int maxSolutions);
+    struct SearchContext {
+        int count;
+        int maxSolutions;
+        TranspositionTable* table;
+        const SearchLimits* limits;
+        uint64_t nodes;
+        bool aborted;
+        Board* firstSolution;
+        
+        bool checkLimits();
+    };
+    
+    struct ParallelSearch;
+    
+    static Result toResult(int count);
+    static Result searchParallel(const Board& board, int maxSolutions, ThreadPool& pool,
+                                 const SearchLimits* limits, Board* firstSolution);
+    
+    static bool solveRecursive(Board& board, std::mt19937& rng, SearchContext& context);
+    static void countSolutionsRecursive(Board& board, SearchContext& context);
+    // The search only checks the values it places, so givens that already
+    // clash would otherwise be searched around
+    static bool hasConflicts(const Board& board);
     static std::pair<int, int> findEmptyCell(const Board& board);
-    static std::vector<int> getShuffledNumbers();
+    static std::vector<int> getShuffledNumbers(std::mt19937& rng);
 };
-
@@ -0,0 +1,100 @@
+//tables.h
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Compile-time cell relationships shared by the board, solvers and UI, so
+// hot loops walk tables instead of dividing and allocating. Cells are
+// numbered row * 9 + col. Units 0-8 are rows, 9-17 columns and 18-26
+// boxes, each listing its cells in row-major order.
+namespace SudokuTables {
+
+constexpr int SIZE = 9;
+constexpr int BOX_SIZE = 3;
+constexpr int CELL_COUNT = SIZE * SIZE;
+constexpr int UNIT_COUNT = 3 * SIZE;
+constexpr int PEER_COUNT = 20;
+
+using Unit = std::array<uint8_t, SIZE>;
+using CellUnits = std::array<uint8_t, 3>;  // row, column and box unit
+using Peers = std::array<uint8_t, PEER_COUNT>;
+
+constexpr std::array<uint8_t, CELL_COUNT> makeRows() {
+    std::array<uint8_t, CELL_COUNT> rows{};
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        rows[cell] = static_cast<uint8_t>(cell / SIZE);
+    }
+    return rows;
+}
+
+constexpr std::array<uint8_t, CELL_COUNT> makeCols() {
+    std::array<uint8_t, CELL_COUNT> cols{};
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        cols[cell] = static_cast<uint8_t>(cell % SIZE);
+    }
+    return cols;
+}
+
+constexpr std::array<uint8_t, CELL_COUNT> makeBoxes() {
+    std::array<uint8_t, CELL_COUNT> boxes{};
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        int row = cell / SIZE;
+        int col = cell % SIZE;
+        boxes[cell] = static_cast<uint8_t>((row / BOX_SIZE) * BOX_SIZE + col / BOX_SIZE);
+    }
+    return boxes;
+}
+
+// Row, column and box (0-8) of each cell
+inline constexpr std::array<uint8_t, CELL_COUNT> ROW_OF = makeRows();
+inline constexpr std::array<uint8_t, CELL_COUNT> COL_OF = makeCols();
+inline constexpr std::array<uint8_t, CELL_COUNT> BOX_OF = makeBoxes();
+
+constexpr std::array<Unit, UNIT_COUNT> makeUnits() {
+    std::array<Unit, UNIT_COUNT> units{};
+    for (int i = 0; i < SIZE; ++i) {
+        for (int j = 0; j < SIZE; ++j) {
+            units[i][j] = static_cast<uint8_t>(i * SIZE + j);
+            units[SIZE + i][j] = static_cast<uint8_t>(j * SIZE + i);
+            int row = (i / BOX_SIZE) * BOX_SIZE + j / BOX_SIZE;
+            int col = (i % BOX_SIZE) * BOX_SIZE + j % BOX_SIZE;
+            units[2 * SIZE + i][j] = static_cast<uint8_t>(row * SIZE + col);
+        }
+    }
+    return units;
+}
+
+constexpr std::array<CellUnits, CELL_COUNT> makeCellUnits() {
+    std::array<CellUnits, CELL_COUNT> cellUnits{};
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        cellUnits[cell][0] = ROW_OF[cell];
+        cellUnits[cell][1] = static_cast<uint8_t>(SIZE + COL_OF[cell]);
+        cellUnits[cell][2] = static_cast<uint8_t>(2 * SIZE + BOX_OF[cell]);
+    }
+    return cellUnits;
+}
+
+// Every cell sharing a row, column or box with the cell, in ascending order
+constexpr std::array<Peers, CELL_COUNT> makePeers() {
+    std::array<Peers, CELL_COUNT> peers{};
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        int count = 0;
+        for (int other = 0; other < CELL_COUNT; ++other) {
+            if (other != cell && (ROW_OF[other] == ROW_OF[cell] || COL_OF[other] == COL_OF[cell] ||
+                                  BOX_OF[other] == BOX_OF[cell])) {
+                peers[cell][count++] = static_cast<uint8_t>(other);
+            }
+        }
+    }
+    return peers;
+}
+
+inline constexpr std::array<Unit, UNIT_COUNT> UNITS = makeUnits();
+inline constexpr std::array<CellUnits, CELL_COUNT> CELL_UNITS = makeCellUnits();
+inline constexpr std::array<Peers, CELL_COUNT> PEERS = makePeers();
+
+static_assert(PEERS[0][PEER_COUNT - 1] == 72, "cell 0's last peer is the bottom of its column");
+static_assert(UNITS[2 * SIZE + 4][0] == 30, "the centre box starts at row 3, column 3");
+
+} // namespace SudokuTables
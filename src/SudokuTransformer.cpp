@@ -0,0 +1,89 @@
+//transformer.cpp
+#include "SudokuTransformer.h"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+std::array<int, Board::SIZE> randomLineMap(std::mt19937& rng) {
+    // Permute the bands (or stacks), then the lines inside each of them
+    std::array<int, Board::BOX_SIZE> bands = {0, 1, 2};
+    std::shuffle(bands.begin(), bands.end(), rng);
+
+    std::array<int, Board::SIZE> lines;
+    for (int b = 0; b < Board::BOX_SIZE; ++b) {
+        std::array<int, Board::BOX_SIZE> inner = {0, 1, 2};
+        std::shuffle(inner.begin(), inner.end(), rng);
+        for (int i = 0; i < Board::BOX_SIZE; ++i) {
+            lines[b * Board::BOX_SIZE + i] = bands[b] * Board::BOX_SIZE + inner[i];
+        }
+    }
+    return lines;
+}
+
+// Source cell that lands on (r, c) as row * SIZE + col
+int sourceCell(const SudokuTransform& transform, int r, int c) {
+    int srcRow = transform.rowMap[r];
+    int srcCol = transform.colMap[c];
+    if (transform.transpose) {
+        std::swap(srcRow, srcCol);
+    }
+    return srcRow * Board::SIZE + srcCol;
+}
+
+} // namespace
+
+SudokuTransform SudokuTransform::identity() {
+    SudokuTransform transform;
+    std::iota(transform.rowMap.begin(), transform.rowMap.end(), 0);
+    std::iota(transform.colMap.begin(), transform.colMap.end(), 0);
+    std::iota(transform.digitMap.begin(), transform.digitMap.end(), 0);
+    transform.transpose = false;
+    return transform;
+}
+
+SudokuTransform SudokuTransform::random(std::mt19937& rng) {
+    SudokuTransform transform = identity();
+    transform.rowMap = randomLineMap(rng);
+    transform.colMap = randomLineMap(rng);
+    std::shuffle(transform.digitMap.begin() + 1, transform.digitMap.end(), rng);
+    transform.transpose = std::uniform_int_distribution<int>(0, 1)(rng) == 1;
+    return transform;
+}
+
+Board SudokuTransformer::apply(const Board& board, const SudokuTransform& transform) {
+    Board result;
+    for (int r = 0; r < Board::SIZE; ++r) {
+        for (int c = 0; c < Board::SIZE; ++c) {
+            int src = sourceCell(transform, r, c);
+            const Cell& cell = board.getCell(src / Board::SIZE, src % Board::SIZE);
+            result.setValue(r, c, transform.digitMap[cell.getValue()]);
+            result.getCell(r, c).setGiven(cell.isGiven());
+        }
+    }
+    return result;
+}
+
+BitboardSolver::Grid SudokuTransformer::apply(const BitboardSolver::Grid& grid,
+                                              const SudokuTransform& transform) {
+    BitboardSolver::Grid result;
+    for (int r = 0; r < Board::SIZE; ++r) {
+        for (int c = 0; c < Board::SIZE; ++c) {
+            result[r * Board::SIZE + c] =
+                static_cast<uint8_t>(transform.digitMap[grid[sourceCell(transform, r, c)]]);
+        }
+    }
+    return result;
+}
+
+void SudokuTransformer::randomize(Board& puzzle, Board& solution) {
+    std::random_device rd;
+    std::mt19937 g(rd());
+    randomize(puzzle, solution, g);
+}
+
+void SudokuTransformer::randomize(Board& puzzle, Board& solution, std::mt19937& rng) {
+    SudokuTransform transform = SudokuTransform::random(rng);
+    puzzle = apply(puzzle, transform);
+    solution = apply(solution, transform);
+}
@@ -0,0 +1,30 @@
+//transformer.h
+#pragma once
+
+#include "BitboardSolver.h"
+#include "Board.h"
+#include <array>
+#include <random>
+
+// Validity-preserving symmetry of the sudoku grid. Applying the same
+// transform to a puzzle and its solution yields an equivalent puzzle with
+// the same uniqueness and difficulty.
+struct SudokuTransform {
+    std::array<int, Board::SIZE> rowMap;      // target row -> source row
+    std::array<int, Board::SIZE> colMap;      // target col -> source col
+    std::array<int, Board::SIZE + 1> digitMap; // source digit -> target digit (0 stays 0)
+    bool transpose;
+
+    static SudokuTransform identity();
+    static SudokuTransform random(std::mt19937& rng);
+};
+
+class SudokuTransformer {
+public:
+    static Board apply(const Board& board, const SudokuTransform& transform);
+    static BitboardSolver::Grid apply(const BitboardSolver::Grid& grid, const SudokuTransform& transform);
+
+    // Replaces puzzle and solution with a randomly transformed equivalent in O(81)
+    static void randomize(Board& puzzle, Board& solution);
+    static void randomize(Board& puzzle, Board& solution, std::mt19937& rng);
+};
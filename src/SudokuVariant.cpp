@@ -0,0 +1,213 @@
+//variant.cpp
+#include "SudokuVariant.h"
+
+namespace {
+
+constexpr int N = SudokuTables::SIZE;
+constexpr int CELLS = SudokuTables::CELL_COUNT;
+
+void addCell(SudokuVariant::CellSet& set, int cell) {
+    set[cell / 64] |= uint64_t(1) << (cell % 64);
+}
+
+bool hasCell(const SudokuVariant::CellSet& set, int cell) {
+    return (set[cell / 64] >> (cell % 64)) & 1;
+}
+
+} // namespace
+
+SudokuVariant::SudokuVariant() : name_("classic") {
+    cellUnitCounts_.fill(0);
+    peers_.fill({0, 0});
+    cageOf_.fill(-1);
+    for (const Unit& unit : SudokuTables::UNITS) {
+        addUnit(unit);
+    }
+}
+
+SudokuVariant SudokuVariant::classic() {
+    return SudokuVariant();
+}
+
+SudokuVariant SudokuVariant::diagonal() {
+    SudokuVariant variant;
+    Unit main;
+    Unit anti;
+    for (int i = 0; i < N; ++i) {
+        main[i] = static_cast<uint8_t>(i * N + i);
+        anti[i] = static_cast<uint8_t>(i * N + (N - 1 - i));
+    }
+    variant.addUnit(main);
+    variant.addUnit(anti);
+    variant.setName("diagonal");
+    return variant;
+}
+
+SudokuVariant SudokuVariant::hyper() {
+    SudokuVariant variant;
+    for (int top : {1, 5}) {
+        for (int left : {1, 5}) {
+            Unit window;
+            for (int i = 0; i < N; ++i) {
+                window[i] = static_cast<uint8_t>((top + i / 3) * N + left + i % 3);
+            }
+            variant.addUnit(window);
+        }
+    }
+    variant.setName("hyper");
+    return variant;
+}
+
+bool SudokuVariant::jigsaw(const Regions& regions, SudokuVariant& variant) {
+    std::array<Unit, N> units;
+    std::array<int, N> sizes{};
+    for (int cell = 0; cell < CELLS; ++cell) {
+        int region = regions[cell];
+        if (region >= N || sizes[region] == N) {
+            return false;
+        }
+        units[region][sizes[region]++] = static_cast<uint8_t>(cell);
+    }
+    
+    // Rows and columns, then the regions in place of the boxes
+    SudokuVariant parsed;
+    parsed.units_.clear();
+    parsed.cellUnitCounts_.fill(0);
+    parsed.peers_.fill({0, 0});
+    for (int unit = 0; unit < 2 * N; ++unit) {
+        parsed.addUnit(SudokuTables::UNITS[unit]);
+    }
+    for (const Unit& unit : units) {
+        parsed.addUnit(unit);
+    }
+    parsed.setName("jigsaw");
+    variant = parsed;
+    return true;
+}
+
+bool SudokuVariant::addUnit(const Unit& cells) {
+    if (static_cast<int>(units_.size()) >= MAX_UNITS) {
+        return false;
+    }
+    for (uint8_t cell : cells) {
+        if (cellUnitCounts_[cell] >= MAX_CELL_UNITS) {
+            return false;
+        }
+    }
+    
+    int index = static_cast<int>(units_.size());
+    units_.push_back(cells);
+    for (uint8_t cell : cells) {
+        cellUnits_[cell][cellUnitCounts_[cell]++] = static_cast<uint8_t>(index);
+        for (uint8_t other : cells) {
+            if (other != cell) {
+                addCell(peers_[cell], other);
+            }
+        }
+    }
+    return true;
+}
+
+bool SudokuVariant::addCage(const Cage& cage) {
+    int size = static_cast<int>(cage.cells.size());
+    if (size == 0 || size > N) {
+        return false;
+    }
+    CellSet seen = {0, 0};
+    for (uint8_t cell : cage.cells) {
+        if (cell >= CELLS || cageOf_[cell] != -1 || hasCell(seen, cell)) {
+            return false;
+        }
+        addCell(seen, cell);
+    }
+    
+    std::vector<uint16_t> combinations;
+    for (int mask = 1; mask < (1 << N); ++mask) {
+        int count = 0;
+        int sum = 0;
+        for (int d = 0; d < N; ++d) {
+            if (mask & (1 << d)) {
+                count++;
+                sum += d + 1;
+            }
+        }
+        if (count == size && sum == cage.sum) {
+            combinations.push_back(static_cast<uint16_t>(mask));
+        }
+    }
+    if (combinations.empty()) {
+        return false;
+    }
+    
+    int index = static_cast<int>(cages_.size());
+    cages_.push_back(cage);
+    cageCombinations_.push_back(combinations);
+    for (uint8_t cell : cage.cells) {
+        cageOf_[cell] = static_cast<int8_t>(index);
+        for (uint8_t other : cage.cells) {
+            if (other != cell) {
+                addCell(peers_[cell], other);
+            }
+        }
+    }
+    return true;
+}
+
+void SudokuVariant::clearCages() {
+    cages_.clear();
+    cageCombinations_.clear();
+    cageOf_.fill(-1);
+    
+    // Cage peers are mixed into the unit peers, so rebuild those
+    std::vector<Unit> units;
+    units.swap(units_);
+    cellUnitCounts_.fill(0);
+    peers_.fill({0, 0});
+    for (const Unit& unit : units) {
+        addUnit(unit);
+    }
+}
+
+const std::string& SudokuVariant::getName() const {
+    return name_;
+}
+
+void SudokuVariant::setName(const std::string& name) {
+    name_ = name;
+}
+
+int SudokuVariant::getUnitCount() const {
+    return static_cast<int>(units_.size());
+}
+
+const SudokuVariant::Unit& SudokuVariant::getUnit(int unit) const {
+    return units_[unit];
+}
+
+int SudokuVariant::getCellUnitCount(int cell) const {
+    return cellUnitCounts_[cell];
+}
+
+const std::array<uint8_t, SudokuVariant::MAX_CELL_UNITS>& SudokuVariant::getCellUnits(int cell) const {
+    return cellUnits_[cell];
+}
+
+const SudokuVariant::CellSet& SudokuVariant::getPeers(int cell) const {
+    return peers_[cell];
+}
+
+bool SudokuVariant::hasCages() const {
+    return !cages_.empty();
+}
+
+const std::vector<Cage>& SudokuVariant::getCages() const {
+    return cages_;
+}
+
+int SudokuVariant::getCageOf(int cell) const {
+    return cageOf_[cell];
+}
+
+const std::vector<uint16_t>& SudokuVariant::getCageCombinations(int cage) const {
+    return cageCombinations_[cage];
+}
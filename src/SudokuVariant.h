@@ -0,0 +1,75 @@
+//variant.h
+#pragma once
+
+#include "SudokuTables.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Killer cage: the digits in the cells are distinct and add up to sum
+struct Cage {
+    std::vector<uint8_t> cells;
+    int sum;
+};
+
+// Description of a 9x9 variant as a set of units (nine cells holding 1-9
+// once each) plus killer cages. Every change recompiles the lookup tables
+// VariantSolver runs on: the units of each cell, a peer bitmask per cell
+// and, for each cage, every digit set that fills it with the right sum.
+class SudokuVariant {
+public:
+    using Unit = SudokuTables::Unit;
+    using Regions = std::array<uint8_t, SudokuTables::CELL_COUNT>;
+    // Bit i of word i / 64 is cell i
+    using CellSet = std::array<uint64_t, 2>;
+    
+    static constexpr int MAX_UNITS = 48;
+    // Row, column, box, two diagonals and a hyper window
+    static constexpr int MAX_CELL_UNITS = 6;
+    
+    // Rows, columns and 3x3 boxes
+    SudokuVariant();
+    
+    static SudokuVariant classic();
+    // X: both main diagonals are units too
+    static SudokuVariant diagonal();
+    // Hyper: four extra 3x3 windows offset by one from the boxes
+    static SudokuVariant hyper();
+    // Jigsaw: regions[cell] (0-8, nine cells each) replaces the boxes.
+    // False if the regions are not nine groups of nine.
+    static bool jigsaw(const Regions& regions, SudokuVariant& variant);
+    
+    // False if a cell would belong to more than MAX_CELL_UNITS units
+    bool addUnit(const Unit& cells);
+    // False if a cell is already caged or no digit set fits the sum
+    bool addCage(const Cage& cage);
+    void clearCages();
+    
+    const std::string& getName() const;
+    void setName(const std::string& name);
+    
+    int getUnitCount() const;
+    const Unit& getUnit(int unit) const;
+    int getCellUnitCount(int cell) const;
+    const std::array<uint8_t, MAX_CELL_UNITS>& getCellUnits(int cell) const;
+    const CellSet& getPeers(int cell) const;
+    
+    bool hasCages() const;
+    const std::vector<Cage>& getCages() const;
+    // Cage index of the cell, or -1
+    int getCageOf(int cell) const;
+    // Digit sets (bit d-1 for digit d) that can fill the cage
+    const std::vector<uint16_t>& getCageCombinations(int cage) const;
+    
+private:
+    std::string name_;
+    std::vector<Unit> units_;
+    std::array<uint8_t, SudokuTables::CELL_COUNT> cellUnitCounts_;
+    std::array<std::array<uint8_t, MAX_CELL_UNITS>, SudokuTables::CELL_COUNT> cellUnits_;
+    std::array<CellSet, SudokuTables::CELL_COUNT> peers_;
+    
+    std::vector<Cage> cages_;
+    std::vector<std::vector<uint16_t>> cageCombinations_;
+    std::array<int8_t, SudokuTables::CELL_COUNT> cageOf_;
+};
@@ -0,0 +1,106 @@
+//threadpool.cpp
+#include "ThreadPool.h"
+
+namespace {
+
+// Lets submit() find the calling worker's own deque
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentIndex = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(int threads)
+    : pending_(0)
+    , nextQueue_(0)
+    , stopping_(false) {
+    int count = resolveThreadCount(threads);
+    for (int i = 0; i < count; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+    for (int i = 0; i < count; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, static_cast<size_t>(i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    condition_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+int ThreadPool::getThreadCount() const {
+    return static_cast<int>(workers_.size());
+}
+
+int ThreadPool::resolveThreadCount(int threads) {
+    if (threads > 0) {
+        return threads;
+    }
+    unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 0 ? static_cast<int>(cores) : 1;
+}
+
+void ThreadPool::enqueue(std::function<void()> job) {
+    size_t index = currentPool == this ? currentIndex
+                                       : nextQueue_.fetch_add(1) % queues_.size();
+    {
+        // Counted first, and under the sleep mutex, so the count never drops
+        // below zero and a worker about to wait cannot miss the job
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        pending_++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->jobs.push_back(std::move(job));
+    }
+    condition_.notify_one();
+}
+
+bool ThreadPool::tryTake(size_t index, std::function<void()>& job) {
+    {
+        WorkQueue& own = *queues_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            pending_--;
+            return true;
+        }
+    }
+    
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        WorkQueue& victim = *queues_[(index + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            pending_--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentIndex = index;
+    
+    for (;;) {
+        std::function<void()> job;
+        if (tryTake(index, job)) {
+            job();
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        condition_.wait(lock, [this]() { return stopping_ || pending_ > 0; });
+        if (stopping_ && pending_ == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,57 @@
+//threadpool.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size work-stealing pool. Each worker owns a deque: tasks submitted
+// from a worker go to its own deque and are run newest-first, while idle
+// workers steal the oldest task from the others. Tasks submitted from
+// outside the pool are spread round-robin.
+class ThreadPool {
+public:
+    // 0 uses one thread per hardware core
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    template <typename F>
+    auto submit(F&& task) -> std::future<decltype(task())> {
+        using R = decltype(task());
+        auto packaged = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+        std::future<R> result = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return result;
+    }
+    
+    int getThreadCount() const;
+    
+    static int resolveThreadCount(int threads);
+    
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> jobs;
+    };
+    
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex sleepMutex_;
+    std::condition_variable condition_;
+    std::atomic<size_t> pending_;
+    std::atomic<size_t> nextQueue_;
+    bool stopping_;
+    
+    void enqueue(std::function<void()> job);
+    bool tryTake(size_t index, std::function<void()>& job);
+    void workerLoop(size_t index);
+};
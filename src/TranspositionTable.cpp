@@ -0,0 +1,54 @@
+//transposition.cpp
+#include "TranspositionTable.h"
+
+TranspositionTable::TranspositionTable(size_t capacity)
+    : mask_(0)
+    , hits_(0)
+    , lookups_(0) {
+    // Round up to a power of two so the slot is a mask of the hash
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    entries_.resize(size);
+    mask_ = size - 1;
+    clear();
+}
+
+bool TranspositionTable::lookup(uint64_t hash, int& solutions) const {
+    lookups_++;
+    const Entry& entry = entries_[hash & mask_];
+    if (entry.solutions < 0 || entry.hash != hash) {
+        return false;
+    }
+    hits_++;
+    solutions = entry.solutions;
+    return true;
+}
+
+void TranspositionTable::store(uint64_t hash, int solutions) {
+    if (solutions < 0 || solutions > 1) {
+        return;
+    }
+    // Always replace: recent subtrees are the likeliest to be revisited
+    Entry& entry = entries_[hash & mask_];
+    entry.hash = hash;
+    entry.solutions = static_cast<int8_t>(solutions);
+}
+
+void TranspositionTable::clear() {
+    for (auto& entry : entries_) {
+        entry.hash = 0;
+        entry.solutions = -1;
+    }
+    hits_ = 0;
+    lookups_ = 0;
+}
+
+size_t TranspositionTable::getHits() const {
+    return hits_;
+}
+
+size_t TranspositionTable::getLookups() const {
+    return lookups_;
+}
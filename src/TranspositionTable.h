@@ -0,0 +1,32 @@
+//transposition.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bounded cache of sub-search results keyed by Board::getHash(). Only
+// exhaustively explored subtrees with zero or exactly one solution are
+// stored, so a hit can replace the whole sub-search. Not thread-safe.
+class TranspositionTable {
+public:
+    explicit TranspositionTable(size_t capacity = 1 << 16);
+    
+    bool lookup(uint64_t hash, int& solutions) const;
+    void store(uint64_t hash, int solutions);
+    void clear();
+    
+    size_t getHits() const;
+    size_t getLookups() const;
+    
+private:
+    struct Entry {
+        uint64_t hash;
+        int8_t solutions; // -1 means empty
+    };
+    
+    std::vector<Entry> entries_;
+    size_t mask_;
+    mutable size_t hits_;
+    mutable size_t lookups_;
+};
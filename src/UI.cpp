@@ -1,5 +1,7 @@
 // ui.cpp
 #include "UI.h"
+#include <array>
+#include <chrono>
 #include <sstream>
 #include <type_traits>
 
@@ -19,7 +21,7 @@ UI::UI(unsigned int windowWidth, unsigned int windowHeight)
     gridColor_ = sf::Color(200, 200, 200);
     thickGridColor_ = sf::Color(100, 100, 100);
     cellColor_ = sf::Color(255, 255, 255);
-    selectedCellColor_ = sf::Color(173, 216, 230)
+    selectedCellColor_ = sf::Color(173, 216, 230);
     highlightColor_ = sf::Color(230, 240, 255);
     givenTextColor_ = sf::Color(0, 0, 0);
     userTextColor_ = sf::Color(30, 144, 255);
@@ -35,29 +37,58 @@ UI::UI(unsigned int windowWidth, unsigned int windowHeight)
 UI::~UI() {
 }
 
-bool UI::initialize() {
-    // Try to load font from assets
-    // First try relative path (for running from build directory)
-    if (font_.openFromFile("assets/fonts/DejaVuSans.ttf")) {
-        fontLoaded_ = true;
-        return true;
+void UI::initialize() {
+    fontLoader_ = std::async(std::launch::async, &UI::loadFont);
+}
+
+bool UI::isFontLoading() const {
+    return fontLoader_.valid();
+}
+
+bool UI::isFontLoaded() const {
+    return fontLoaded_;
+}
+
+std::unique_ptr<sf::Font> UI::loadFont() {
+    // In order of preference: DejaVuSans relative to the build directory,
+    // then to the source directory, then Roboto. All are probed at once and
+    // the most preferred one that opens wins.
+    static const std::array<const char*, 3> paths = {
+        "assets/fonts/DejaVuSans.ttf",
+        "../assets/fonts/DejaVuSans.ttf",
+        "assets/fonts/Roboto-Regular.ttf"
+    };
+    
+    std::array<std::future<std::unique_ptr<sf::Font>>, paths.size()> probes;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        probes[i] = std::async(std::launch::async, [path = paths[i]]() {
+            auto font = std::make_unique<sf::Font>();
+            return font->openFromFile(path) ? std::move(font) : nullptr;
+        });
     }
     
-    // Try absolute path from source directory
-    if (font_.openFromFile("../assets/fonts/DejaVuSans.ttf")) {
-        fontLoaded_ = true;
-        return true;
+    std::unique_ptr<sf::Font> chosen;
+    for (auto& probe : probes) {
+        std::unique_ptr<sf::Font> font = probe.get();
+        if (font && !chosen) {
+            chosen = std::move(font);
+        }
     }
-    
-    // Fallback: try Roboto if DejaVuSans not found
-    if (font_.openFromFile("assets/fonts/Roboto-Regular.ttf")) {
-        fontLoaded_ = true;
-        return true;
+    return chosen;
+}
+
+void UI::pollFont() {
+    if (!fontLoader_.valid() ||
+        fontLoader_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
     }
     
     // Font not found - game will still run but text may not render
-    fontLoaded_ = false;
-    return false;
+    std::unique_ptr<sf::Font> font = fontLoader_.get();
+    if (font) {
+        font_ = std::move(*font);
+        fontLoaded_ = true;
+    }
 }
 
 void UI::setupButtons() {
@@ -92,7 +123,18 @@ void UI::setupButtons() {
     difficultyButton_.hovered = false;
     difficultyButton_.active = false;
     
-    buttons_ = {newGameButton_, hintButton_, notesButton_, pauseButton_, difficultyButton_};
+    solveButton_.bounds = sf::FloatRect(sf::Vector2f(startX, startY + 5 * (buttonHeight + buttonSpacing)), sf::Vector2f(buttonWidth, buttonHeight));
+    solveButton_.text = "Solve";
+    solveButton_.hovered = false;
+    solveButton_.active = false;
+    
+    autoNotesButton_.bounds = sf::FloatRect(sf::Vector2f(startX, startY + 6 * (buttonHeight + buttonSpacing)), sf::Vector2f(buttonWidth, buttonHeight));
+    autoNotesButton_.text = "Auto Notes";
+    autoNotesButton_.hovered = false;
+    autoNotesButton_.active = false;
+    
+    buttons_ = {newGameButton_, hintButton_, notesButton_, pauseButton_, difficultyButton_, solveButton_,
+                autoNotesButton_};
 }
 
 void UI::handleEvent(sf::Event event, Game& game) {
@@ -147,6 +189,10 @@ void UI::handleEvent(sf::Event event, Game& game) {
             } else if (isPointInButton(mousePosF, difficultyButton_)) {
                 game.pause();
                 difficultyMenuOpen_ = true;
+            } else if (isPointInButton(mousePosF, solveButton_)) {
+                game.toggleAutoSolve();
+            } else if (isPointInButton(mousePosF, autoNotesButton_)) {
+                game.toggleAutoNotes();
             } else {
                 // Check board click
                 auto cell = getCellFromMouse(mousePos.x, mousePos.y);
@@ -188,9 +234,27 @@ void UI::handleEvent(sf::Event event, Game& game) {
             game.pause();
         }
         
+        // Ctrl+Z undoes, Ctrl+Y or Ctrl+Shift+Z redoes (Cmd on macOS)
+        if (e->control || e->system) {
+            if (e->code == sf::Keyboard::Key::Z && !e->shift) {
+                game.undo();
+            } else if (e->code == sf::Keyboard::Key::Y || e->code == sf::Keyboard::Key::Z) {
+                game.redo();
+            }
+        }
+        
         if (e->code == sf::Keyboard::Key::N) {
             game.toggleNotesMode();
         }
+        
+        // Plain S and A only, so Ctrl+S or Cmd+A never start a solve
+        if (e->code == sf::Keyboard::Key::S && !e->control && !e->system) {
+            game.toggleAutoSolve();
+        }
+        
+        if (e->code == sf::Keyboard::Key::A && !e->control && !e->system) {
+            game.toggleAutoNotes();
+        }
     } else if (event.is<sf::Event::MouseMoved>()) {
         const auto* e = event.getIf<sf::Event::MouseMoved>();
         if (e) {
@@ -200,13 +264,19 @@ void UI::handleEvent(sf::Event event, Game& game) {
 }
 
 void UI::update(const Game& game) {
+    pollFont();
+    
     // Update button states
     notesButton_.active = game.isNotesMode();
     pauseButton_.active = game.isPaused();
+    solveButton_.active = game.isAutoSolving();
+    autoNotesButton_.active = game.isAutoNotes();
     
     // Update button text
     pauseButton_.text = game.isPaused() ? "Resume" : "Pause";
     notesButton_.text = game.isNotesMode() ? "Notes: ON" : "Notes: OFF";
+    solveButton_.text = game.isAutoSolving() ? "Stop" : "Solve";
+    autoNotesButton_.text = game.isAutoNotes() ? "Auto: ON" : "Auto: OFF";
     
     // Update hints button
     std::ostringstream hintText;
@@ -214,7 +284,8 @@ void UI::update(const Game& game) {
     hintButton_.text = hintText.str();
     
     // Update buttons vector
-    buttons_ = {newGameButton_, hintButton_, notesButton_, pauseButton_, difficultyButton_};
+    buttons_ = {newGameButton_, hintButton_, notesButton_, pauseButton_, difficultyButton_, solveButton_,
+                autoNotesButton_};
 }
 
 void UI::render(sf::RenderWindow& window, const Game& game) {
@@ -223,6 +294,7 @@ void UI::render(sf::RenderWindow& window, const Game& game) {
     renderBoard(window, game);
     renderButtons(window);
     renderTimer(window, game);
+    renderHint(window, game);
     
     if (difficultyMenuOpen_) {
         renderDifficultyMenu(window);
@@ -236,8 +308,18 @@ void UI::render(sf::RenderWindow& window, const Game& game) {
 }
 
 void UI::renderBoard(sf::RenderWindow& window, const Game& game) {
-    const Board& board = game.getBoard();
-    auto selected = game.getSelectedCell();
+    // While the solver animates, show its partial board and follow its cursor
+    bool autoSolving = game.isAutoSolving();
+    const Board& board = autoSolving ? game.getAutoSolver().getBoard() : game.getBoard();
+    auto selected = autoSolving ? game.getAutoSolver().getLastCell() : game.getSelectedCell();
+    
+    // Highlight the selected cell's row, column and box
+    std::array<bool, SudokuTables::CELL_COUNT> highlighted{};
+    if (selected.first >= 0 && selected.second >= 0) {
+        for (uint8_t peer : SudokuTables::PEERS[selected.first * Board::SIZE + selected.second]) {
+            highlighted[peer] = true;
+        }
+    }
     
     // Draw cell backgrounds and highlights
     for (int r = 0; r < 9; ++r) {
@@ -248,23 +330,9 @@ void UI::renderBoard(sf::RenderWindow& window, const Game& game) {
             sf::RectangleShape cellRect(sf::Vector2f(cellSize_, cellSize_));
             cellRect.setPosition(sf::Vector2f(x, y));
             
-            // Highlight row, column, and box if cell is selected
-            bool isHighlighted = false;
-            if (selected.first == r || selected.second == c) {
-                isHighlighted = true;
-            } else if (selected.first >= 0 && selected.second >= 0) {
-                int selectedBoxRow = selected.first / 3;
-                int selectedBoxCol = selected.second / 3;
-                int cellBoxRow = r / 3;
-                int cellBoxCol = c / 3;
-                if (selectedBoxRow == cellBoxRow && selectedBoxCol == cellBoxCol) {
-                    isHighlighted = true;
-                }
-            }
-            
             if (selected.first == r && selected.second == c) {
                 cellRect.setFillColor(selectedCellColor_);
-            } else if (isHighlighted) {
+            } else if (highlighted[r * Board::SIZE + c]) {
                 cellRect.setFillColor(highlightColor_);
             } else {
                 cellRect.setFillColor(cellColor_);
@@ -315,7 +383,7 @@ void UI::renderCell(sf::RenderWindow& window, int row, int col, const Cell& cell
                                    textBounds.position.y + textBounds.size.y / 2.0f));
         
         window.draw(text);
-    } else if (!cell.getNotes().empty()) {
+    } else if (cell.getNotes() != 0) {
         // Draw notes
         renderNotes(window, row, col, cell);
     }
@@ -327,7 +395,9 @@ void UI::renderNotes(sf::RenderWindow& window, int row, int col, const Cell& cel
     float noteSize = cellSize_ / 3.0f;
     float fontSize = 14.0f;
     
-    for (int note : cell.getNotes()) {
+    for (int note = 1; note <= 9; ++note) {
+        if (!cell.hasNote(note)) continue;
+        
         int noteRow = (note - 1) / 3;
         int noteCol = (note - 1) % 3;
         
@@ -374,6 +444,17 @@ void UI::renderTimer(sf::RenderWindow& window, const Game& game) {
     window.draw(text);
 }
 
+void UI::renderHint(sf::RenderWindow& window, const Game& game) {
+    const Hint& hint = game.getLastHint();
+    if (hint.technique == HintTechnique::NONE) {
+        return;
+    }
+    
+    sf::Text text = createText(HintEngine::describe(hint), 14, noteTextColor_,
+                               boardOffsetX_, boardOffsetY_ + boardSize_ + 50.0f);
+    window.draw(text);
+}
+
 void UI::renderDifficultyMenu(sf::RenderWindow& window) {
     // Semi-transparent overlay
     sf::RectangleShape overlay(sf::Vector2f(windowWidth_, windowHeight_));
@@ -491,6 +572,8 @@ void UI::updateButtonHover(const sf::Vector2i& mousePos) {
     notesButton_.hovered = isPointInButton(mousePosF, notesButton_);
     pauseButton_.hovered = isPointInButton(mousePosF, pauseButton_);
     difficultyButton_.hovered = isPointInButton(mousePosF, difficultyButton_);
+    solveButton_.hovered = isPointInButton(mousePosF, solveButton_);
+    autoNotesButton_.hovered = isPointInButton(mousePosF, autoNotesButton_);
 }
 
 sf::Text UI::createText(const std::string& str, unsigned int size, 
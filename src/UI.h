@@ -3,6 +3,8 @@
 
 #include <SFML/Graphics.hpp>
 #include "Game.h"
+#include <future>
+#include <memory>
 #include <string>
 #include <vector>
 #include <variant>
@@ -20,7 +22,11 @@ public:
     UI(unsigned int windowWidth, unsigned int windowHeight);
     ~UI();
     
-    bool initialize();
+    // Starts loading the font on a background thread and returns at once;
+    // text is left out of frames drawn before it arrives
+    void initialize();
+    bool isFontLoading() const;
+    bool isFontLoaded() const;
     void handleEvent(sf::Event event, Game& game);
     void update(const Game& game);
     void render(sf::RenderWindow& window, const Game& game);
@@ -35,6 +41,7 @@ private:
     
     sf::Font font_;
     bool fontLoaded_;
+    std::future<std::unique_ptr<sf::Font>> fontLoader_;
     
     // Board rendering
     float boardSize_;
@@ -68,8 +75,12 @@ private:
     Button notesButton_;
     Button pauseButton_;
     Button difficultyButton_;
+    Button solveButton_;
+    Button autoNotesButton_;
     
     // Helper methods
+    static std::unique_ptr<sf::Font> loadFont();
+    void pollFont();
     void setupButtons();
     void renderBoard(sf::RenderWindow& window, const Game& game);
     void renderCell(sf::RenderWindow& window, int row, int col, const Cell& cell, 
@@ -77,6 +88,7 @@ private:
     void renderNotes(sf::RenderWindow& window, int row, int col, const Cell& cell);
     void renderButtons(sf::RenderWindow& window);
     void renderTimer(sf::RenderWindow& window, const Game& game);
+    void renderHint(sf::RenderWindow& window, const Game& game);
     void renderDifficultyMenu(sf::RenderWindow& window);
     void renderPauseOverlay(sf::RenderWindow& window);
     
@@ -0,0 +1,209 @@
+//variant_generator.cpp
+#include "VariantGenerator.h"
+#include <algorithm>
+
+namespace {
+
+constexpr int N = SudokuTables::SIZE;
+constexpr int CELLS = SudokuTables::CELL_COUNT;
+
+} // namespace
+
+VariantPuzzle VariantGenerator::generate(const SudokuVariant& variant, Difficulty difficulty,
+                                         const GeneratorOptions& options) {
+    std::mt19937 rng(options.seed ? *options.seed : std::random_device()());
+    
+    VariantPuzzle result{variant, {}, {}, 0};
+    if (!fillSolution(result, rng)) {
+        return result; // the variant has no solution; clueCount stays 0
+    }
+    removeClues(result, SudokuGenerator::getClueCount(difficulty), rng);
+    return result;
+}
+
+VariantPuzzle VariantGenerator::generateKiller(const SudokuVariant& variant, Difficulty difficulty,
+                                               const GeneratorOptions& options) {
+    std::mt19937 rng(options.seed ? *options.seed : std::random_device()());
+    
+    VariantPuzzle result{variant, {}, {}, 0};
+    result.variant.clearCages();
+    if (!fillSolution(result, rng)) {
+        return result;
+    }
+    for (const Cage& cage : randomCages(result.solution, rng)) {
+        result.variant.addCage(cage);
+    }
+    
+    int targetClues = SudokuGenerator::getClueCount(difficulty) -
+                      SudokuGenerator::getClueCount(Difficulty::EXPERT);
+    removeClues(result, std::max(targetClues, 0), rng);
+    return result;
+}
+
+VariantPuzzle VariantGenerator::generateJigsaw(Difficulty difficulty,
+                                               const GeneratorOptions& options) {
+    std::mt19937 rng(options.seed ? *options.seed : std::random_device()());
+    
+    VariantPuzzle result{SudokuVariant(), {}, {}, 0};
+    for (int layout = 0; layout < JIGSAW_LAYOUTS; ++layout) {
+        if (!SudokuVariant::jigsaw(randomRegions(rng), result.variant)) continue;
+        if (fillSolution(result, rng)) {
+            removeClues(result, SudokuGenerator::getClueCount(difficulty), rng);
+            return result;
+        }
+    }
+    return result;
+}
+
+SudokuVariant::Regions VariantGenerator::randomRegions(std::mt19937& rng) {
+    SudokuVariant::Regions regions;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        regions[cell] = static_cast<uint8_t>(SudokuTables::BOX_OF[cell]);
+    }
+    
+    // Trading a cell each way keeps every region at nine cells; the trade
+    // is undone if either region falls apart
+    std::uniform_int_distribution<int> cellDist(0, CELLS - 1);
+    for (int swap = 0; swap < JIGSAW_SWAPS; ++swap) {
+        int a = cellDist(rng);
+        int row = SudokuTables::ROW_OF[a];
+        int col = SudokuTables::COL_OF[a];
+        const int neighbours[4][2] = {{row - 1, col}, {row + 1, col}, {row, col - 1}, {row, col + 1}};
+        const auto& next = neighbours[std::uniform_int_distribution<int>(0, 3)(rng)];
+        if (next[0] < 0 || next[0] >= N || next[1] < 0 || next[1] >= N) continue;
+        uint8_t from = regions[a];
+        uint8_t to = regions[next[0] * N + next[1]];
+        if (from == to) continue;
+        
+        // A cell of the other region that touches this one goes back in exchange
+        std::vector<int> returns;
+        for (int cell = 0; cell < CELLS; ++cell) {
+            if (regions[cell] != to || cell == next[0] * N + next[1]) continue;
+            int r = SudokuTables::ROW_OF[cell];
+            int c = SudokuTables::COL_OF[cell];
+            if ((r > 0 && regions[cell - N] == from) || (r < N - 1 && regions[cell + N] == from) ||
+                (c > 0 && regions[cell - 1] == from) || (c < N - 1 && regions[cell + 1] == from)) {
+                returns.push_back(cell);
+            }
+        }
+        if (returns.empty()) continue;
+        int b = returns[std::uniform_int_distribution<size_t>(0, returns.size() - 1)(rng)];
+        
+        regions[a] = to;
+        regions[b] = from;
+        if (!isConnected(regions, from) || !isConnected(regions, to)) {
+            regions[a] = from;
+            regions[b] = to;
+        }
+    }
+    return regions;
+}
+
+bool VariantGenerator::isConnected(const SudokuVariant::Regions& regions, int region) {
+    std::array<bool, CELLS> reached{};
+    std::vector<int> stack;
+    for (int cell = 0; cell < CELLS && stack.empty(); ++cell) {
+        if (regions[cell] == region) {
+            reached[cell] = true;
+            stack.push_back(cell);
+        }
+    }
+    
+    int count = 0;
+    while (!stack.empty()) {
+        int cell = stack.back();
+        stack.pop_back();
+        count++;
+        int row = SudokuTables::ROW_OF[cell];
+        int col = SudokuTables::COL_OF[cell];
+        const int neighbours[4][2] = {{row - 1, col}, {row + 1, col}, {row, col - 1}, {row, col + 1}};
+        for (const auto& next : neighbours) {
+            if (next[0] < 0 || next[0] >= N || next[1] < 0 || next[1] >= N) continue;
+            int other = next[0] * N + next[1];
+            if (!reached[other] && regions[other] == region) {
+                reached[other] = true;
+                stack.push_back(other);
+            }
+        }
+    }
+    return count == N;
+}
+
+bool VariantGenerator::fillSolution(VariantPuzzle& result, std::mt19937& rng) {
+    for (int attempt = 0; attempt < FILL_RESTARTS; ++attempt) {
+        result.solution.fill(0);
+        if (VariantSolver::randomFill(result.variant, result.solution, rng, FILL_NODE_BUDGET)) {
+            result.puzzle = result.solution;
+            result.clueCount = CELLS;
+            return true;
+        }
+    }
+    return false;
+}
+
+void VariantGenerator::removeClues(VariantPuzzle& result, int targetClues, std::mt19937& rng) {
+    std::vector<int> positions(CELLS);
+    for (int i = 0; i < CELLS; ++i) {
+        positions[i] = i;
+    }
+    std::shuffle(positions.begin(), positions.end(), rng);
+    
+    for (int cell : positions) {
+        if (result.clueCount <= targetClues) break;
+        
+        uint8_t value = result.puzzle[cell];
+        result.puzzle[cell] = 0;
+        if (VariantSolver::hasUniqueSolution(result.variant, result.puzzle)) {
+            result.clueCount--;
+        } else {
+            result.puzzle[cell] = value;
+        }
+    }
+}
+
+std::vector<Cage> VariantGenerator::randomCages(const VariantSolver::Grid& solution,
+                                                std::mt19937& rng) {
+    // Grow each cage from a random uncaged cell into random orthogonal
+    // neighbours, never repeating a digit of the solution within a cage
+    std::array<bool, CELLS> caged{};
+    std::vector<int> order(CELLS);
+    for (int i = 0; i < CELLS; ++i) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), rng);
+    
+    std::vector<Cage> cages;
+    for (int start : order) {
+        if (caged[start]) continue;
+        
+        int size = std::uniform_int_distribution<int>(1, MAX_CAGE_SIZE)(rng);
+        Cage cage{{static_cast<uint8_t>(start)}, solution[start]};
+        uint16_t digits = static_cast<uint16_t>(1 << solution[start]);
+        caged[start] = true;
+        
+        while (static_cast<int>(cage.cells.size()) < size) {
+            std::vector<int> frontier;
+            for (uint8_t cell : cage.cells) {
+                int row = SudokuTables::ROW_OF[cell];
+                int col = SudokuTables::COL_OF[cell];
+                const int neighbours[4][2] = {{row - 1, col}, {row + 1, col}, {row, col - 1}, {row, col + 1}};
+                for (const auto& next : neighbours) {
+                    if (next[0] < 0 || next[0] >= N || next[1] < 0 || next[1] >= N) continue;
+                    int other = next[0] * N + next[1];
+                    if (!caged[other] && !(digits & (1 << solution[other]))) {
+                        frontier.push_back(other);
+                    }
+                }
+            }
+            if (frontier.empty()) break;
+            
+            int chosen = frontier[std::uniform_int_distribution<size_t>(0, frontier.size() - 1)(rng)];
+            cage.cells.push_back(static_cast<uint8_t>(chosen));
+            cage.sum += solution[chosen];
+            digits |= static_cast<uint16_t>(1 << solution[chosen]);
+            caged[chosen] = true;
+        }
+        cages.push_back(cage);
+    }
+    return cages;
+}
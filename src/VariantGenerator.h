@@ -0,0 +1,52 @@
+//variant_generator.h
+#pragma once
+
+#include "SudokuGenerator.h"
+#include "SudokuVariant.h"
+#include "VariantSolver.h"
+#include <random>
+#include <vector>
+
+struct VariantPuzzle {
+    SudokuVariant variant;  // with the generated cages for killer puzzles
+    VariantSolver::Grid puzzle;
+    VariantSolver::Grid solution;
+    int clueCount;
+};
+
+class VariantGenerator {
+public:
+    static constexpr int MAX_CAGE_SIZE = 4;
+    // Filling restarts with fresh randomness after this many nodes, and
+    // gives up after FILL_RESTARTS attempts (the variant may be unsolvable)
+    static constexpr uint64_t FILL_NODE_BUDGET = 20000;
+    static constexpr int FILL_RESTARTS = 200;
+    // Cell swaps between neighbouring regions that shape a random jigsaw,
+    // and how many layouts generateJigsaw tries before giving up
+    static constexpr int JIGSAW_SWAPS = 300;
+    static constexpr int JIGSAW_LAYOUTS = 20;
+    
+    // Fills a grid under the variant's constraints and removes clues while
+    // the solution stays unique, down to the difficulty's clue target.
+    // clueCount is 0 if no grid could be filled.
+    static VariantPuzzle generate(const SudokuVariant& variant, Difficulty difficulty,
+                                  const GeneratorOptions& options);
+    // Killer: random cages of up to MAX_CAGE_SIZE cells are laid over the
+    // solution and take their sums from it, replacing the variant's own
+    // cages. The cages carry most of the information, so the clue target
+    // is lowered by the EXPERT target; EXPERT killers have no givens.
+    static VariantPuzzle generateKiller(const SudokuVariant& variant, Difficulty difficulty,
+                                        const GeneratorOptions& options);
+    // Jigsaw on a fresh random layout; a layout that no grid fills is
+    // replaced by another. clueCount is 0 if none of them filled.
+    static VariantPuzzle generateJigsaw(Difficulty difficulty, const GeneratorOptions& options);
+    // Nine connected regions of nine cells, grown from the boxes by swapping
+    // cells across region borders
+    static SudokuVariant::Regions randomRegions(std::mt19937& rng);
+    
+private:
+    static bool isConnected(const SudokuVariant::Regions& regions, int region);
+    static bool fillSolution(VariantPuzzle& result, std::mt19937& rng);
+    static void removeClues(VariantPuzzle& result, int targetClues, std::mt19937& rng);
+    static std::vector<Cage> randomCages(const VariantSolver::Grid& solution, std::mt19937& rng);
+};
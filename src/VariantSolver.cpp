@@ -0,0 +1,256 @@
+//variant_solver.cpp
+#include "VariantSolver.h"
+#include <algorithm>
+
+namespace {
+
+constexpr int N = SudokuTables::SIZE;
+constexpr int CELLS = SudokuTables::CELL_COUNT;
+constexpr uint16_t ALL_DIGITS = 0x1FF;
+
+using Grid = VariantSolver::Grid;
+
+constexpr std::array<uint8_t, 512> makePopcounts() {
+    std::array<uint8_t, 512> counts{};
+    for (int mask = 0; mask < 512; ++mask) {
+        for (int bit = mask; bit; bit &= bit - 1) {
+            counts[mask]++;
+        }
+    }
+    return counts;
+}
+
+constexpr std::array<uint8_t, 512> POPCOUNT = makePopcounts();
+
+// FIXED_UNITS > 0 when every cell is in exactly that many units, which
+// lets the compiler unroll the unit loops; CAGES compiles the cage checks
+// out of variants without them. Classic and jigsaw run as Search<3, false>.
+template <int FIXED_UNITS, bool CAGES>
+struct Search {
+    // Compiled tables copied out of the variant so the hot loop does not
+    // call across translation units
+    std::array<std::array<uint8_t, SudokuVariant::MAX_CELL_UNITS>, CELLS> cellUnits;
+    std::array<uint8_t, CELLS> cellUnitCounts;
+    std::array<int8_t, CELLS> cageOf;
+    std::vector<const std::vector<uint16_t>*> cageCombinations;
+    
+    Grid cells;
+    std::array<uint16_t, SudokuVariant::MAX_UNITS> used{};
+    std::array<uint16_t, CELLS> cagePlaced{};
+    
+    uint64_t maxSolutions = 1;
+    uint64_t count = 0;
+    Grid* firstSolution = nullptr;
+    const SearchLimits* limits = nullptr;
+    std::mt19937* rng = nullptr;
+    uint64_t maxNodes = 0;
+    uint64_t nodes = 0;
+    bool aborted = false;
+    bool stopped = false;
+    
+    explicit Search(const SudokuVariant& variant) {
+        for (int cell = 0; cell < CELLS; ++cell) {
+            cellUnits[cell] = variant.getCellUnits(cell);
+            cellUnitCounts[cell] = static_cast<uint8_t>(variant.getCellUnitCount(cell));
+            cageOf[cell] = static_cast<int8_t>(variant.getCageOf(cell));
+        }
+        for (size_t cage = 0; cage < variant.getCages().size(); ++cage) {
+            cageCombinations.push_back(&variant.getCageCombinations(static_cast<int>(cage)));
+        }
+    }
+    
+    bool load(const Grid& grid) {
+        cells.fill(0);
+        for (int i = 0; i < CELLS; ++i) {
+            int value = grid[i];
+            if (value == 0) continue;
+            if (value > N || !(candidates(i) & (1 << (value - 1)))) {
+                return false;
+            }
+            place(i, value - 1);
+        }
+        return true;
+    }
+    
+    int unitCount(int cell) const {
+        return FIXED_UNITS > 0 ? FIXED_UNITS : cellUnitCounts[cell];
+    }
+    
+    uint16_t candidates(int cell) const {
+        uint16_t taken = 0;
+        const uint8_t* units = cellUnits[cell].data();
+        for (int k = 0; k < unitCount(cell); ++k) {
+            taken |= used[units[k]];
+        }
+        uint16_t mask = ALL_DIGITS & ~taken;
+        
+        int cage = cageOf[cell];
+        if (CAGES && cage >= 0 && mask) {
+            // Digits that extend the cage's placed digits to a full set
+            uint16_t placed = cagePlaced[cage];
+            uint16_t allowed = 0;
+            for (uint16_t combination : *cageCombinations[cage]) {
+                if ((combination & placed) == placed) {
+                    allowed |= combination;
+                }
+            }
+            mask &= allowed & ~placed;
+        }
+        return mask;
+    }
+    
+    int pickCell(uint16_t& bestMask) const {
+        int best = -1;
+        int bestCount = N + 1;
+        for (int i = 0; i < CELLS; ++i) {
+            if (cells[i] != 0) continue;
+            uint16_t mask = candidates(i);
+            int count = POPCOUNT[mask];
+            if (count < bestCount) {
+                best = i;
+                bestCount = count;
+                bestMask = mask;
+                if (count <= 1) break;
+            }
+        }
+        return best;
+    }
+    
+    void place(int cell, int digit) {
+        uint16_t bit = static_cast<uint16_t>(1 << digit);
+        cells[cell] = static_cast<uint8_t>(digit + 1);
+        const uint8_t* units = cellUnits[cell].data();
+        for (int k = 0; k < unitCount(cell); ++k) {
+            used[units[k]] |= bit;
+        }
+        if (CAGES && cageOf[cell] >= 0) {
+            cagePlaced[cageOf[cell]] |= bit;
+        }
+    }
+    
+    void unplace(int cell, int digit) {
+        uint16_t bit = static_cast<uint16_t>(~(1 << digit));
+        cells[cell] = 0;
+        const uint8_t* units = cellUnits[cell].data();
+        for (int k = 0; k < unitCount(cell); ++k) {
+            used[units[k]] &= bit;
+        }
+        if (CAGES && cageOf[cell] >= 0) {
+            cagePlaced[cageOf[cell]] &= bit;
+        }
+    }
+    
+    void run() {
+        ++nodes;
+        if ((limits && nodes % SearchLimits::NODES_PER_CHECK == 0 && limits->shouldStop()) ||
+            (maxNodes != 0 && nodes > maxNodes)) {
+            aborted = true;
+            return;
+        }
+        
+        uint16_t mask = 0;
+        int best = pickCell(mask);
+        if (best == -1) {
+            if (count == 0 && firstSolution) {
+                *firstSolution = cells;
+            }
+            if (++count >= maxSolutions) {
+                stopped = true;
+            }
+            return;
+        }
+        
+        int digits[N];
+        int digitCount = 0;
+        for (int d = 0; d < N; ++d) {
+            if (mask & (1 << d)) {
+                digits[digitCount++] = d;
+            }
+        }
+        if (rng) {
+            std::shuffle(digits, digits + digitCount, *rng);
+        }
+        
+        for (int k = 0; k < digitCount; ++k) {
+            place(best, digits[k]);
+            run();
+            unplace(best, digits[k]);
+            if (stopped || aborted) {
+                return;
+            }
+        }
+    }
+};
+
+template <typename Visit>
+auto withSearch(const SudokuVariant& variant, Visit&& visit) {
+    bool uniform = true;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        uniform = uniform && variant.getCellUnitCount(cell) == 3;
+    }
+    if (variant.hasCages()) {
+        Search<0, true> search(variant);
+        return visit(search);
+    } else if (uniform) {
+        Search<3, false> search(variant);
+        return visit(search);
+    }
+    Search<0, false> search(variant);
+    return visit(search);
+}
+
+} // namespace
+
+int VariantSolver::countSolutions(const SudokuVariant& variant, const Grid& grid, int maxSolutions,
+                                  Grid* firstSolution, const SearchLimits* limits,
+                                  uint64_t* nodes) {
+    if (nodes) {
+        *nodes = 0;
+    }
+    return withSearch(variant, [&](auto& search) {
+        if (!search.load(grid)) {
+            return 0;
+        }
+        search.maxSolutions = static_cast<uint64_t>(std::max(maxSolutions, 1));
+        search.firstSolution = firstSolution;
+        search.limits = limits;
+        search.run();
+        
+        if (nodes) {
+            *nodes = search.nodes;
+        }
+        return search.aborted ? -1 : static_cast<int>(search.count);
+    });
+}
+
+bool VariantSolver::hasUniqueSolution(const SudokuVariant& variant, const Grid& grid) {
+    return countSolutions(variant, grid, 2) == 1;
+}
+
+bool VariantSolver::randomFill(const SudokuVariant& variant, Grid& grid, std::mt19937& rng,
+                               uint64_t maxNodes) {
+    return withSearch(variant, [&](auto& search) {
+        if (!search.load(grid)) {
+            return false;
+        }
+        search.rng = &rng;
+        search.maxNodes = maxNodes;
+        search.firstSolution = &grid;
+        search.run();
+        return search.count > 0;
+    });
+}
+
+bool VariantSolver::isValidPlacement(const SudokuVariant& variant, const Grid& grid, int cell,
+                                     int value) {
+    if (value < 1 || value > N) {
+        return false;
+    }
+    const SudokuVariant::CellSet& peers = variant.getPeers(cell);
+    for (int peer = 0; peer < CELLS; ++peer) {
+        if (((peers[peer / 64] >> (peer % 64)) & 1) && grid[peer] == value) {
+            return false;
+        }
+    }
+    return true;
+}
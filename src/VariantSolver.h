@@ -0,0 +1,34 @@
+//variant_solver.h
+#pragma once
+
+#include "BitboardSolver.h"
+#include "CancellationToken.h"
+#include "SudokuVariant.h"
+#include <cstdint>
+#include <random>
+
+// BitboardSolver generalised to any SudokuVariant: each unit keeps a 9-bit
+// used mask, a cell's candidates are the digits free in all of its units
+// and allowed by its cage's digit sets, and the search branches on the
+// cell with the fewest candidates.
+class VariantSolver {
+public:
+    using Grid = BitboardSolver::Grid;
+    
+    // Same contract as BitboardSolver::countSolutions.
+    // nodes, when given, is set to the number of search nodes visited.
+    static int countSolutions(const SudokuVariant& variant, const Grid& grid, int maxSolutions,
+                              Grid* firstSolution = nullptr,
+                              const SearchLimits* limits = nullptr,
+                              uint64_t* nodes = nullptr);
+    static bool hasUniqueSolution(const SudokuVariant& variant, const Grid& grid);
+    // Gives up after maxNodes (0 = no limit). Irregular variants can send
+    // one ordering into a long dead end; restarting with a fresh rng
+    // usually finds a grid quickly.
+    static bool randomFill(const SudokuVariant& variant, Grid& grid, std::mt19937& rng,
+                           uint64_t maxNodes = 0);
+    
+    // No peer (unit or cage mate) already holds the value; cage sums are
+    // only enforced by the search
+    static bool isValidPlacement(const SudokuVariant& variant, const Grid& grid, int cell, int value);
+};
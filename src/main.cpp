@@ -1,24 +1,35 @@
 //main.cpp
 #include <SFML/Graphics.hpp>
+#include "BatchTool.h"
 #include "Game.h"
+#include "StartupTimer.h"
 #include "UI.h"
 #include <iostream>
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return BatchTool::run(argc, argv);
+    }
+    
+    StartupTimer startup;
+    
     const unsigned int windowWidth = 800;
     const unsigned int windowHeight = 700;
     
     sf::RenderWindow window(sf::VideoMode(sf::Vector2u(windowWidth, windowHeight)), 
                            "Sudoku Game", sf::Style::Close);
     window.setFramerateLimit(60);
+    startup.mark("window");
     
-    Game game;
+    // The font loads in the background while the game starts, and the
+    // first frames go out without text rather than waiting for it
     UI ui(windowWidth, windowHeight);
+    ui.initialize();
     
-    if (!ui.initialize()) {
-        std::cerr << "Warning: Could not load font. Text rendering may not work properly." << std::endl;
-        std::cerr << "Please ensure assets/fonts/Roboto-Regular.ttf exists." << std::endl;
-    }
+    // Picks up where the last session left off, even after a power cut;
+    // otherwise starts a built-in puzzle with no generation up front
+    Game game("sudoku.save");
+    startup.mark("game");
     
     sf::Clock clock;
     
@@ -34,11 +45,24 @@ int main() {
         // Update game timer
         game.updateTimer();
         
+        // Advance the watch-it-solve animation within this frame's budget
+        game.updateAutoSolve();
+        
         // Update UI
         ui.update(game);
         
         // Render
         ui.render(window, game);
+        startup.mark("first frame");
+        
+        if (!startup.hasMark("font") && !ui.isFontLoading()) {
+            startup.mark("font");
+            startup.report(std::clog);
+            if (!ui.isFontLoaded()) {
+                std::cerr << "Warning: Could not load font. Text rendering may not work properly." << std::endl;
+                std::cerr << "Please ensure assets/fonts/Roboto-Regular.ttf exists." << std::endl;
+            }
+        }
         
         // Check for completion
         if (game.isComplete()) {